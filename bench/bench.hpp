@@ -0,0 +1,58 @@
+#pragma once
+
+// Shared by the bench_jsonstruct sources: allocation counting and the
+// registration helpers.  Every benchmark reports allocs/op; the throughput
+// ones also report bytes/s (of compact JSON text) and items/s (objects).
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+    /// Number of global operator new calls so far (alloc_count.cpp).
+    std::size_t allocation_count();
+
+    /// Run body once per iteration, then report allocations per iteration.
+    template<typename Body>
+    void run(benchmark::State& state, Body&& body) {
+        const std::size_t before = allocation_count();
+        for (auto _ : state) {
+            body();
+        }
+        state.counters["allocs/op"] = benchmark::Counter(
+            static_cast<double>(allocation_count() - before), benchmark::Counter::kAvgIterations);
+    }
+
+    /// As run(), also reporting bytes and objects processed per iteration.
+    template<typename Body>
+    void run(benchmark::State& state, std::size_t bytes, std::size_t objects, Body&& body) {
+        run(state, std::forward<Body>(body));
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * objects));
+    }
+
+    /// Register a benchmark named name, running func(state).
+    template<typename Func>
+    benchmark::internal::Benchmark* add(const std::string& name, Func&& func) {
+        return benchmark::RegisterBenchmark(name.c_str(), std::forward<Func>(func));
+    }
+
+    /// n reproducible numbers in about [-1e6, 1e6].
+    template<typename Num>
+    std::vector<Num> numbers(std::size_t n) {
+        std::mt19937_64 rng(42);
+        std::vector<Num> out(n);
+        for (auto& x : out) {
+            if constexpr (std::is_integral_v<Num>) x = static_cast<Num>(rng() % 2000001) - 1000000;
+            else x = std::uniform_real_distribution<Num>(-1e6, 1e6)(rng);
+        }
+        return out;
+    }
+}
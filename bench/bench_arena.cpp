@@ -0,0 +1,120 @@
+// Decode plus teardown of a fleet of ServerConfig-shaped entries, with
+// std::string/std::vector on the heap against std::pmr ones in an Arena.
+
+#include "bench.hpp"
+
+#include <jsonstruct/arena.hpp>
+#include <jsonstruct/jsoncpp.hpp>
+#include <jsonstruct/nlohmannjson.hpp>
+#include <jsonstruct/stream.hpp>
+#include <jsonstruct/stream_writer.hpp>
+
+#include <memory>
+
+namespace bench {
+namespace {
+
+    using namespace jsonstruct;
+
+    struct HeapServer {
+        std::string host;
+        int port = 0;
+        std::string user;
+        std::string password;
+        std::vector<std::string> allowed_ips;
+
+        static auto config_fields() {
+            return std::make_tuple(
+                make_field("host", &HeapServer::host), make_field("port", &HeapServer::port),
+                make_field("user", &HeapServer::user), make_field("password", &HeapServer::password),
+                make_field("allowed_ips", &HeapServer::allowed_ips));
+        }
+    };
+
+    struct HeapFleet {
+        std::vector<HeapServer> servers;
+        static auto config_fields() { return std::make_tuple(make_field("servers", &HeapFleet::servers)); }
+    };
+
+    struct ArenaServer {
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+        std::pmr::string host;
+        int port = 0;
+        std::pmr::string user;
+        std::pmr::string password;
+        std::pmr::vector<std::pmr::string> allowed_ips;
+
+        ArenaServer(const allocator_type& a = {}) : host(a), user(a), password(a), allowed_ips(a) {}
+        ArenaServer(const ArenaServer& o, const allocator_type& a)
+            : host(o.host, a), port(o.port), user(o.user, a), password(o.password, a), allowed_ips(o.allowed_ips, a) {}
+
+        static auto config_fields() {
+            return std::make_tuple(
+                make_field("host", &ArenaServer::host), make_field("port", &ArenaServer::port),
+                make_field("user", &ArenaServer::user), make_field("password", &ArenaServer::password),
+                make_field("allowed_ips", &ArenaServer::allowed_ips));
+        }
+    };
+
+    struct ArenaFleet {
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+        std::pmr::vector<ArenaServer> servers;
+
+        ArenaFleet(const allocator_type& a = {}) : servers(a) {}
+        ArenaFleet(const ArenaFleet& o, const allocator_type& a) : servers(o.servers, a) {}
+
+        static auto config_fields() { return std::make_tuple(make_field("servers", &ArenaFleet::servers)); }
+    };
+
+    // Strings long enough to defeat the small-string optimization.
+    HeapFleet fleet(std::size_t n) {
+        HeapFleet out;
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::string id = std::to_string(i);
+            out.servers.push_back({"server-" + id + ".datacenter.example.org", 8000 + static_cast<int>(i % 1000),
+                                   "service-account-" + id, "a-password-that-is-long-" + id,
+                                   {"10.0.0." + id, "2001:0db8:85a3:0000:0000:8a2e:0370:" + id, "192.168.100." + id}});
+        }
+        return out;
+    }
+
+    // decode(out) fills a HeapFleet or an ArenaFleet.
+    template<typename Decode>
+    void add_case(const std::string& name, std::size_t bytes, std::size_t n, Decode decode) {
+        add(name + "/heap", [=](benchmark::State& state) {
+            run(state, bytes, n, [&] {
+                HeapFleet out;
+                decode(out);
+            });
+        });
+        add(name + "/arena", [=](benchmark::State& state) {
+            Arena arena(1 << 20);
+            run(state, bytes, n, [&] {
+                {
+                    ArenaFleet out = arena.make<ArenaFleet>();
+                    decode(out);
+                }
+                arena.release();
+            });
+        });
+    }
+
+    const bool registered = [] {
+        for (std::size_t n : {100, 1000, 10000}) {
+            const HeapFleet src = fleet(n);
+            auto jv = std::make_shared<const Json::Value>(Converter<HeapFleet, jsoncpp::Traits>::toJson(src));
+            auto nj = std::make_shared<const nlohmann::json>(Converter<HeapFleet, nlohmannjson::Traits>::toJson(src));
+            auto text = std::make_shared<const std::string>(stream::to_json_string(src));
+            const std::string suffix = "/" + std::to_string(n);
+            add_case("arena/jsoncpp" + suffix, text->size(), n, [jv](auto& out) {
+                Converter<std::decay_t<decltype(out)>, jsoncpp::Traits>::fromJson(*jv, out);
+            });
+            add_case("arena/nlohmann" + suffix, text->size(), n, [nj](auto& out) {
+                Converter<std::decay_t<decltype(out)>, nlohmannjson::Traits>::fromJson(*nj, out);
+            });
+            add_case("arena/stream" + suffix, text->size(), n, [text](auto& out) { stream::from_json(*text, out); });
+        }
+        return true;
+    }();
+}
+}
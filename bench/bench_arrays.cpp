@@ -0,0 +1,80 @@
+// Numeric vectors converted element by element against the bulk path
+// (get_numbers()/create_numbers(), Reader::number_array()).
+
+#include "bench.hpp"
+
+#include <jsonstruct/jsoncpp.hpp>
+#include <jsonstruct/nlohmannjson.hpp>
+#include <jsonstruct/stream.hpp>
+#include <jsonstruct/stream_writer.hpp>
+
+#include <cstdint>
+#include <memory>
+
+namespace bench {
+namespace {
+
+    using namespace jsonstruct;
+
+    constexpr std::size_t array_size = 100000;
+
+    template<typename Num, typename Traits>
+    void add_dom(const std::string& num_name, const char* backend) {
+        using Conv = Converter<std::vector<Num>, Traits>;
+        auto vals = std::make_shared<const std::vector<Num>>(numbers<Num>(array_size));
+        auto doc = std::make_shared<const typename Traits::ValueType>(Conv::toJson(*vals));
+        const std::size_t bytes = stream::json_size(*vals);
+        const std::string name = "/" + num_name + "/" + backend;
+        add("arrays/fromJson" + name + "/each", [=](benchmark::State& state) {
+            std::vector<Num> out;
+            run(state, bytes, array_size, [&] { benchmark::DoNotOptimize(Conv::fromJsonEach(*doc, out)); });
+        });
+        add("arrays/fromJson" + name + "/bulk", [=](benchmark::State& state) {
+            std::vector<Num> out;
+            run(state, bytes, array_size, [&] { benchmark::DoNotOptimize(Conv::fromJson(*doc, out)); });
+        });
+        add("arrays/toJson" + name + "/each", [=](benchmark::State& state) {
+            run(state, bytes, array_size, [&] { auto j = Conv::toJsonEach(*vals); benchmark::DoNotOptimize(j); });
+        });
+        add("arrays/toJson" + name + "/bulk", [=](benchmark::State& state) {
+            run(state, bytes, array_size, [&] { auto j = Conv::toJson(*vals); benchmark::DoNotOptimize(j); });
+        });
+    }
+
+    template<typename Num>
+    void add_stream(const std::string& num_name) {
+        auto text = std::make_shared<const std::string>(stream::to_json_string(numbers<Num>(array_size)));
+        const std::size_t bytes = text->size();
+        add("arrays/fromJson/" + num_name + "/stream/each", [=](benchmark::State& state) {
+            std::vector<Num> out;
+            run(state, bytes, array_size, [&] {
+                stream::Reader in(*text);
+                benchmark::DoNotOptimize(stream::SequenceDecoder<std::vector<Num>>::decode_each(in, out));
+            });
+        });
+        add("arrays/fromJson/" + num_name + "/stream/bulk", [=](benchmark::State& state) {
+            std::vector<Num> out;
+            run(state, bytes, array_size, [&] {
+                stream::Reader in(*text);
+                benchmark::DoNotOptimize(stream::Decoder<std::vector<Num>>::decode(in, out));
+            });
+        });
+    }
+
+    const bool registered = [] {
+        add_dom<int, jsoncpp::Traits>("int", "jsoncpp");
+        add_dom<double, jsoncpp::Traits>("double", "jsoncpp");
+        add_dom<int, nlohmannjson::Traits>("int", "nlohmann");
+        add_dom<double, nlohmannjson::Traits>("double", "nlohmann");
+        add_dom<std::int64_t, jsoncpp::Traits>("int64", "jsoncpp");
+        add_dom<float, jsoncpp::Traits>("float", "jsoncpp");
+        add_dom<std::int64_t, nlohmannjson::Traits>("int64", "nlohmann");
+        add_dom<float, nlohmannjson::Traits>("float", "nlohmann");
+        add_stream<int>("int");
+        add_stream<double>("double");
+        add_stream<std::int64_t>("int64");
+        add_stream<float>("float");
+        return true;
+    }();
+}
+}
@@ -0,0 +1,32 @@
+// NDJSON batch decoding of ServerConfig records on 1 to 8 threads.
+
+#include "datasets.hpp"
+
+#include <jsonstruct/batch.hpp>
+#include <jsonstruct/stream_writer.hpp>
+
+#include <memory>
+
+namespace bench {
+namespace {
+
+    constexpr std::size_t nrecords = 100000;
+
+    const bool registered = [] {
+        auto text = std::make_shared<std::string>();
+        for (const auto& config : servers(nrecords)) {
+            *text += stream::to_json_string(config);
+            *text += '\n';
+        }
+        add("batch/ndjson/servers", [=](benchmark::State& state) {
+            stream::BatchOptions options;
+            options.threads = static_cast<unsigned>(state.range(0));
+            run(state, text->size(), nrecords, [&] {
+                auto result = stream::decode_ndjson<ServerConfig>(*text, options);
+                benchmark::DoNotOptimize(result.records.data());
+            });
+        })->ArgName("threads")->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+        return true;
+    }();
+}
+}
@@ -0,0 +1,82 @@
+// The CBOR backend against the text ones: encode and decode throughput,
+// with the size on the wire reported as wire_bytes.  bytes/s is of each
+// format's own encoding.
+
+#include "datasets.hpp"
+
+#include <jsonstruct/cbor.hpp>
+#include <jsonstruct/nlohmannjson.hpp>
+#include <jsonstruct/stream.hpp>
+#include <jsonstruct/stream_writer.hpp>
+
+#include <memory>
+
+namespace bench {
+namespace {
+
+    template<typename T>
+    void add_formats(const std::string& dataset, T value, std::size_t objects) {
+        auto shared = std::make_shared<const T>(std::move(value));
+        auto text = std::make_shared<const std::string>(stream::to_json_string(*shared));
+        auto bytes = std::make_shared<const std::vector<std::uint8_t>>(cbor::to_cbor(*shared));
+        const double text_size = static_cast<double>(text->size());
+        const double cbor_size = static_cast<double>(bytes->size());
+        using Conv = Converter<T, nlohmannjson::Traits>;
+
+        add("wire/encode/" + dataset + "/cbor", [=](benchmark::State& state) {
+            std::vector<std::uint8_t> out;
+            run(state, bytes->size(), objects, [&] {
+                out.clear();
+                cbor::write_cbor(*shared, out);
+                benchmark::DoNotOptimize(out.data());
+            });
+            state.counters["wire_bytes"] = cbor_size;
+        });
+        add("wire/encode/" + dataset + "/stream", [=](benchmark::State& state) {
+            std::string out;
+            run(state, text->size(), objects, [&] {
+                out.clear();
+                stream::write_json(*shared, out);
+                benchmark::DoNotOptimize(out.data());
+            });
+            state.counters["wire_bytes"] = text_size;
+        });
+        add("wire/encode/" + dataset + "/nlohmann", [=](benchmark::State& state) {
+            run(state, text->size(), objects, [&] {
+                auto out = Conv::toJson(*shared).dump();
+                benchmark::DoNotOptimize(out.data());
+            });
+            state.counters["wire_bytes"] = text_size;
+        });
+        add("wire/decode/" + dataset + "/cbor", [=](benchmark::State& state) {
+            T out{};
+            run(state, bytes->size(), objects, [&] {
+                benchmark::DoNotOptimize(cbor::from_cbor(*bytes, out));
+            });
+            state.counters["wire_bytes"] = cbor_size;
+        });
+        add("wire/decode/" + dataset + "/stream", [=](benchmark::State& state) {
+            T out{};
+            run(state, text->size(), objects, [&] {
+                benchmark::DoNotOptimize(stream::from_json(*text, out));
+            });
+            state.counters["wire_bytes"] = text_size;
+        });
+        add("wire/decode/" + dataset + "/nlohmann", [=](benchmark::State& state) {
+            T out{};
+            run(state, text->size(), objects, [&] {
+                benchmark::DoNotOptimize(Conv::fromJson(nlohmann::json::parse(*text), out));
+            });
+            state.counters["wire_bytes"] = text_size;
+        });
+    }
+
+    const bool registered = [] {
+        add_formats("servers", servers(1000), 1000);
+        add_formats("doubles", numbers<double>(10000), 10000);
+        add_formats("ints", numbers<int>(10000), 10000);
+        add_formats("shapes", shapes(1000), 1000);
+        return true;
+    }();
+}
+}
@@ -0,0 +1,64 @@
+// Text arriving in pieces the size of a network segment: fed to a
+// ChunkedDecoder as it comes, against gathering it all into one buffer
+// and then decoding it whole with stream::from_json() or a DOM.
+
+#include "datasets.hpp"
+
+#include <jsonstruct/chunked.hpp>
+#include <jsonstruct/nlohmannjson.hpp>
+#include <jsonstruct/stream.hpp>
+#include <jsonstruct/stream_writer.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace bench {
+namespace {
+
+    constexpr std::size_t records = 10000;
+    constexpr std::size_t piece = 1460;
+
+    // Call func(piece) for each piece of text in turn.
+    template<typename Func>
+    void in_pieces(const std::string& text, Func&& func) {
+        for (std::size_t at = 0; at < text.size(); at += piece) {
+            func(std::string_view(text).substr(at, piece));
+        }
+    }
+
+    const bool registered = [] {
+        using Records = std::vector<ServerConfig>;
+        auto text = std::make_shared<const std::string>(stream::to_json_string(servers(records)));
+        const std::size_t bytes = text->size();
+
+        add("chunked/feed", [=](benchmark::State& state) {
+            Records out;
+            run(state, bytes, records, [&] {
+                stream::ChunkedDecoder decoder(out);
+                bool ok = true;
+                in_pieces(*text, [&](std::string_view p) { ok = ok && decoder.feed(p); });
+                benchmark::DoNotOptimize(ok && decoder.finish());
+            });
+        });
+        add("chunked/buffer/stream", [=](benchmark::State& state) {
+            Records out;
+            run(state, bytes, records, [&] {
+                std::string buffer;
+                in_pieces(*text, [&](std::string_view p) { buffer.append(p); });
+                benchmark::DoNotOptimize(stream::from_json(buffer, out));
+            });
+        });
+        add("chunked/buffer/nlohmann", [=](benchmark::State& state) {
+            Records out;
+            run(state, bytes, records, [&] {
+                std::string buffer;
+                in_pieces(*text, [&](std::string_view p) { buffer.append(p); });
+                benchmark::DoNotOptimize(
+                    Converter<Records, nlohmannjson::Traits>::fromJson(nlohmann::json::parse(buffer), out));
+            });
+        });
+        return true;
+    }();
+}
+}
@@ -0,0 +1,98 @@
+// Arrays of flat records decoded into std::vector<Trade> against the
+// columnar Columns<Trade>, and a scan of one numeric column of each.
+
+#include "bench.hpp"
+
+#include <jsonstruct/columnar.hpp>
+#include <jsonstruct/jsoncpp.hpp>
+#include <jsonstruct/nlohmannjson.hpp>
+
+#include <memory>
+#include <numeric>
+
+namespace bench {
+namespace {
+
+    using namespace jsonstruct;
+
+    struct Trade {
+        int id = 0;
+        double price = 0;
+        double quantity = 0;
+        int timestamp = 0;
+        bool buy = false;
+
+        static auto config_fields() {
+            return std::make_tuple(make_field("id", &Trade::id), make_field("price", &Trade::price),
+                                   make_field("quantity", &Trade::quantity), make_field("timestamp", &Trade::timestamp),
+                                   make_field("buy", &Trade::buy));
+        }
+    };
+
+    constexpr std::size_t ntrades = 100000;
+
+    std::vector<Trade> trades(std::size_t n) {
+        const auto prices = numbers<double>(n);
+        const auto ints = numbers<int>(n);
+        std::vector<Trade> out(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = Trade{static_cast<int>(i), prices[i], prices[i] / 7, ints[i], i % 2 == 0};
+        }
+        return out;
+    }
+
+    template<typename Traits>
+    void add_dom(const char* backend, const std::vector<Trade>& records, std::size_t bytes) {
+        auto doc = std::make_shared<const typename Traits::ValueType>(
+            Converter<std::vector<Trade>, Traits>::toJson(records));
+        add(std::string("columnar/fromJson/") + backend + "/rows", [=](benchmark::State& state) {
+            std::vector<Trade> out;
+            run(state, bytes, ntrades, [&] {
+                benchmark::DoNotOptimize(Converter<std::vector<Trade>, Traits>::fromJson(*doc, out));
+            });
+        });
+        add(std::string("columnar/fromJson/") + backend + "/columns", [=](benchmark::State& state) {
+            Columns<Trade> out;
+            run(state, bytes, ntrades, [&] {
+                benchmark::DoNotOptimize(Converter<Columns<Trade>, Traits>::fromJson(*doc, out));
+            });
+        });
+    }
+
+    const bool registered = [] {
+        const auto records = trades(ntrades);
+        auto text = std::make_shared<const std::string>(stream::to_json_string(records));
+        const std::size_t bytes = text->size();
+        add_dom<jsoncpp::Traits>("jsoncpp", records, bytes);
+        add_dom<nlohmannjson::Traits>("nlohmann", records, bytes);
+        add("columnar/fromJson/stream/rows", [=](benchmark::State& state) {
+            std::vector<Trade> out;
+            run(state, bytes, ntrades, [&] { benchmark::DoNotOptimize(stream::from_json(*text, out)); });
+        });
+        add("columnar/fromJson/stream/columns", [=](benchmark::State& state) {
+            Columns<Trade> out;
+            run(state, bytes, ntrades, [&] { benchmark::DoNotOptimize(stream::from_json(*text, out)); });
+        });
+
+        // Summing one field: a strided walk over the records against a
+        // contiguous column.
+        auto rows = std::make_shared<const std::vector<Trade>>(records);
+        auto columns = std::make_shared<Columns<Trade>>();
+        for (const auto& trade : records) columns->push_back(trade);
+        add("columnar/scan/price/rows", [=](benchmark::State& state) {
+            run(state, ntrades * sizeof(double), ntrades, [&] {
+                double sum = 0;
+                for (const auto& trade : *rows) sum += trade.price;
+                benchmark::DoNotOptimize(sum);
+            });
+        });
+        add("columnar/scan/price/columns", [=](benchmark::State& state) {
+            const auto& prices = columns->column<1>();
+            run(state, ntrades * sizeof(double), ntrades, [&] {
+                benchmark::DoNotOptimize(std::accumulate(prices.begin(), prices.end(), 0.0));
+            });
+        });
+        return true;
+    }();
+}
+}
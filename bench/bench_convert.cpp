@@ -0,0 +1,79 @@
+// Throughput of every backend over the generated datasets: DOM to struct
+// (fromJson) and back (toJson) for JsonCPP and nlohmann/json, and text to
+// struct and back for the stream backend.
+
+#include "datasets.hpp"
+#include "wide.hpp"
+
+#include <jsonstruct/jsoncpp.hpp>
+#include <jsonstruct/nlohmannjson.hpp>
+#include <jsonstruct/stream.hpp>
+#include <jsonstruct/stream_writer.hpp>
+
+#include <memory>
+
+namespace bench {
+namespace {
+
+    template<typename T, typename Traits>
+    void add_dom(const std::string& dataset, const char* backend, std::shared_ptr<const T> value,
+                 std::size_t bytes, std::size_t objects) {
+        using Conv = Converter<T, Traits>;
+        auto doc = std::make_shared<const typename Traits::ValueType>(Conv::toJson(*value));
+        add("fromJson/" + dataset + "/" + backend, [=](benchmark::State& state) {
+            T out{};
+            run(state, bytes, objects, [&] {
+                benchmark::DoNotOptimize(Conv::fromJson(*doc, out));
+            });
+        });
+        add("toJson/" + dataset + "/" + backend, [=](benchmark::State& state) {
+            run(state, bytes, objects, [&] {
+                auto j = Conv::toJson(*value);
+                benchmark::DoNotOptimize(j);
+            });
+        });
+    }
+
+    template<typename T>
+    void add_stream(const std::string& dataset, std::shared_ptr<const T> value, std::size_t objects) {
+        auto text = std::make_shared<const std::string>(stream::to_json_string(*value));
+        const std::size_t bytes = text->size();
+        add("fromJson/" + dataset + "/stream", [=](benchmark::State& state) {
+            T out{};
+            run(state, bytes, objects, [&] {
+                benchmark::DoNotOptimize(stream::from_json(*text, out));
+            });
+        });
+        add("toJson/" + dataset + "/stream", [=](benchmark::State& state) {
+            std::string out;
+            run(state, bytes, objects, [&] {
+                out.clear();
+                stream::write_json(*value, out);
+                benchmark::DoNotOptimize(out.data());
+            });
+        });
+    }
+
+    // objects: the number of structs or elements the dataset holds.
+    template<typename T>
+    void add_dataset(const std::string& dataset, T value, std::size_t objects) {
+        auto shared = std::make_shared<const T>(std::move(value));
+        const std::size_t bytes = stream::json_size(*shared);
+        add_dom<T, jsoncpp::Traits>(dataset, "jsoncpp", shared, bytes, objects);
+        add_dom<T, nlohmannjson::Traits>(dataset, "nlohmann", shared, bytes, objects);
+        add_stream<T>(dataset, shared, objects);
+    }
+
+    const bool registered = [] {
+        add_dataset("server_config", ServerConfig{}, 1);
+        add_dataset("servers_1000", servers(1000), 1000);
+        add_dataset("deep_100", chain(100), 100);
+        add_dataset("wide_100", Wide100{}, 1);
+        add_dataset("doubles_100k", numbers<double>(100000), 100000);
+        add_dataset("ints_100k", numbers<int>(100000), 100000);
+        add_dataset("mixed_variants_1000", mixed(1000), 1000);
+        add_dataset("tagged_variants_1000", shapes(1000), 1000);
+        return true;
+    }();
+}
+}
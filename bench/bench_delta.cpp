@@ -0,0 +1,73 @@
+// Reloading a config of which one field changed: a full fromJson against
+// diff_apply(), which converts only that field.
+
+#include "datasets.hpp"
+#include "wide.hpp"
+
+#include <jsonstruct/delta.hpp>
+#include <jsonstruct/jsoncpp.hpp>
+#include <jsonstruct/nlohmannjson.hpp>
+
+#include <memory>
+
+namespace bench {
+namespace {
+
+    struct Cluster {
+        ServerConfig primary;
+        ServerConfig backup;
+        Wide100 limits;
+        std::vector<std::string> peers;
+
+        static auto config_fields() {
+            return std::make_tuple(make_field("primary", &Cluster::primary), make_field("backup", &Cluster::backup),
+                                   make_field("limits", &Cluster::limits), make_field("peers", &Cluster::peers));
+        }
+    };
+
+    Cluster cluster() {
+        Cluster out;
+        const auto configs = servers(2);
+        out.primary = configs[0];
+        out.backup = configs[1];
+        for (int i = 0; i < 200; ++i) out.peers.push_back("peer-" + std::to_string(i) + ".cluster.example.org");
+        return out;
+    }
+
+    template<typename Traits>
+    void add_reload(const char* backend) {
+        using Conv = Converter<Cluster, Traits>;
+        // Two versions of the document, differing in one field, applied in turn.
+        auto before = std::make_shared<const typename Traits::ValueType>(Conv::toJson(cluster()));
+        Cluster changed = cluster();
+        changed.limits.f42 = 1;
+        auto after = std::make_shared<const typename Traits::ValueType>(Conv::toJson(changed));
+
+        add(std::string("reload/cluster/") + backend + "/fromJson", [=](benchmark::State& state) {
+            Cluster out;
+            bool flip = false;
+            run(state, [&] {
+                flip = !flip;
+                benchmark::DoNotOptimize(Conv::fromJson(flip ? *after : *before, out));
+            });
+        });
+        add(std::string("reload/cluster/") + backend + "/diff_apply", [=](benchmark::State& state) {
+            Cluster out;
+            DeltaState delta;
+            diff_apply<Traits>(out, *before, delta);
+            bool flip = false;
+            run(state, [&] {
+                flip = !flip;
+                auto changes = diff_apply<Traits>(out, flip ? *after : *before, delta);
+                benchmark::DoNotOptimize(changes.paths.data());
+            });
+        });
+    }
+
+    const bool registered = [] {
+        add_reload<jsoncpp::Traits>("jsoncpp");
+        add_reload<nlohmannjson::Traits>("nlohmann");
+        return true;
+    }();
+}
+}
@@ -0,0 +1,52 @@
+// Struct member matching: one lookup per declared field (fromJsonLookup)
+// against one pass over the document's members (fromJsonDispatch), for
+// structs of 2 to 200 fields.  Documents have all or every tenth field,
+// with or without members the struct does not declare.
+
+#include "bench.hpp"
+#include "wide.hpp"
+
+#include <jsonstruct/jsoncpp.hpp>
+#include <jsonstruct/nlohmannjson.hpp>
+
+#include <memory>
+
+namespace bench {
+namespace {
+
+    template<typename T, typename Traits>
+    void add_wide(const std::string& struct_name, const char* backend) {
+        using JsonValue = typename Traits::ValueType;
+        constexpr std::size_t nfields = field_count<T>;
+        struct Shape { std::size_t stride, unknown; };
+        for (Shape shape : {Shape{1, 0}, Shape{10, 0}, Shape{1, 4 * nfields}, Shape{10, 4 * nfields}}) {
+            auto doc = std::make_shared<const JsonValue>(wide_document<JsonValue, T>(shape.stride, shape.unknown));
+            const std::string name = "dispatch/" + struct_name + "/" + backend
+                + "/present:" + std::to_string(100 / shape.stride) + "%/unknown:" + std::to_string(shape.unknown);
+            add(name + "/lookup", [=](benchmark::State& state) {
+                T obj;
+                run(state, [&] { benchmark::DoNotOptimize(Converter<T, Traits>::fromJsonLookup(*doc, obj)); });
+            });
+            add(name + "/dispatch", [=](benchmark::State& state) {
+                T obj;
+                run(state, [&] { benchmark::DoNotOptimize(Converter<T, Traits>::fromJsonDispatch(*doc, obj)); });
+            });
+        }
+    }
+
+    template<typename Traits>
+    void add_backend(const char* backend) {
+        add_wide<Wide2, Traits>("Wide2", backend);
+        add_wide<Wide10, Traits>("Wide10", backend);
+        add_wide<Wide50, Traits>("Wide50", backend);
+        add_wide<Wide100, Traits>("Wide100", backend);
+        add_wide<Wide200, Traits>("Wide200", backend);
+    }
+
+    const bool registered = [] {
+        add_backend<jsoncpp::Traits>("jsoncpp");
+        add_backend<nlohmannjson::Traits>("nlohmann");
+        return true;
+    }();
+}
+}
@@ -0,0 +1,106 @@
+// An array of enum names decoded into the enum against the workaround it
+// replaces: decoding into std::string and looking each name up by hand.
+
+#include "bench.hpp"
+
+#include <jsonstruct/nlohmannjson.hpp>
+#include <jsonstruct/stream.hpp>
+#include <jsonstruct/stream_writer.hpp>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace bench {
+
+    enum class Severity { trace, debug, info, notice, warning, error, critical, fatal };
+
+    constexpr auto json_enum_names(Severity) {
+        return std::array{std::pair{Severity::trace, "trace"}, std::pair{Severity::debug, "debug"},
+                          std::pair{Severity::info, "info"}, std::pair{Severity::notice, "notice"},
+                          std::pair{Severity::warning, "warning"}, std::pair{Severity::error, "error"},
+                          std::pair{Severity::critical, "critical"}, std::pair{Severity::fatal, "fatal"}};
+    }
+
+namespace {
+
+    using namespace jsonstruct;
+
+    constexpr std::size_t array_size = 10000;
+
+    std::vector<Severity> severities() {
+        std::vector<Severity> out;
+        for (int x : numbers<int>(array_size)) out.push_back(static_cast<Severity>((x + 1000000) % 8));
+        return out;
+    }
+
+    // The hand-written lookup a std::string member needed.
+    bool lookup(const std::string& name, Severity& out) {
+        static const std::unordered_map<std::string, Severity> table = [] {
+            std::unordered_map<std::string, Severity> t;
+            for (const auto& [value, n] : json_enum_names(Severity{})) t.emplace(n, value);
+            return t;
+        }();
+        const auto it = table.find(name);
+        if (it == table.end()) return false;
+        out = it->second;
+        return true;
+    }
+
+    bool lookup_all(const std::vector<std::string>& names, std::vector<Severity>& out) {
+        out.resize(names.size());
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            if (!lookup(names[i], out[i])) return false;
+        }
+        return true;
+    }
+
+    void add_dom() {
+        auto doc = std::make_shared<const nlohmann::json>(
+            Converter<std::vector<Severity>, nlohmannjson::Traits>::toJson(severities()));
+        const std::size_t bytes = doc->dump().size();
+        add("enum/fromJson/nlohmann/strings", [=](benchmark::State& state) {
+            std::vector<std::string> names;
+            std::vector<Severity> out;
+            run(state, bytes, array_size, [&] {
+                const bool ok = Converter<std::vector<std::string>, nlohmannjson::Traits>::fromJson(*doc, names);
+                benchmark::DoNotOptimize(ok && lookup_all(names, out));
+            });
+        });
+        add("enum/fromJson/nlohmann/enum", [=](benchmark::State& state) {
+            std::vector<Severity> out;
+            run(state, bytes, array_size, [&] {
+                benchmark::DoNotOptimize(Converter<std::vector<Severity>, nlohmannjson::Traits>::fromJson(*doc, out));
+            });
+        });
+    }
+
+    void add_stream() {
+        auto vals = std::make_shared<const std::vector<Severity>>(severities());
+        auto text = std::make_shared<const std::string>(stream::to_json_string(*vals));
+        const std::size_t bytes = text->size();
+        add("enum/fromJson/stream/strings", [=](benchmark::State& state) {
+            std::vector<std::string> names;
+            std::vector<Severity> out;
+            run(state, bytes, array_size, [&] {
+                benchmark::DoNotOptimize(stream::from_json(*text, names) && lookup_all(names, out));
+            });
+        });
+        add("enum/fromJson/stream/enum", [=](benchmark::State& state) {
+            std::vector<Severity> out;
+            run(state, bytes, array_size, [&] { benchmark::DoNotOptimize(stream::from_json(*text, out)); });
+        });
+        add("enum/toJson/stream/enum", [=](benchmark::State& state) {
+            run(state, bytes, array_size, [&] { benchmark::DoNotOptimize(stream::to_json_string(*vals)); });
+        });
+    }
+
+    const bool registered = [] {
+        add_dom();
+        add_stream();
+        return true;
+    }();
+}
+}
@@ -0,0 +1,64 @@
+// Reading three fields of a Wide200 document: a full conversion against
+// a Lazy view, on the DOM libraries and on the text.
+
+#include "bench.hpp"
+#include "wide.hpp"
+
+#include <jsonstruct/jsoncpp.hpp>
+#include <jsonstruct/lazy.hpp>
+#include <jsonstruct/nlohmannjson.hpp>
+
+#include <memory>
+
+namespace bench {
+namespace {
+
+    int three_fields(const Wide200& obj) { return obj.id + obj.f50 + obj.g99; }
+
+    template<typename View>
+    int view_three_fields(View& view) { return view.get(&Wide200::id) + view.get(&Wide200::f50) + view.get(&Wide200::g99); }
+
+    template<typename Traits>
+    void add_dom(const char* backend) {
+        using JsonValue = typename Traits::ValueType;
+        auto doc = std::make_shared<const JsonValue>(wide_document<JsonValue, Wide200>(1, 0));
+        add(std::string("lazy/Wide200/") + backend + "/fromJson", [=](benchmark::State& state) {
+            run(state, [&] {
+                Wide200 obj;
+                Converter<Wide200, Traits>::fromJson(*doc, obj);
+                benchmark::DoNotOptimize(three_fields(obj));
+            });
+        });
+        add(std::string("lazy/Wide200/") + backend + "/lazy", [=](benchmark::State& state) {
+            run(state, [&] {
+                Lazy<Wide200, Traits> view(*doc);
+                benchmark::DoNotOptimize(view_three_fields(view));
+            });
+        });
+    }
+
+    void add_stream() {
+        auto text = std::make_shared<const std::string>(wide_document<nlohmann::json, Wide200>(1, 0).dump());
+        add("lazy/Wide200/stream/from_json", [=](benchmark::State& state) {
+            run(state, text->size(), 1, [&] {
+                Wide200 obj;
+                stream::from_json(*text, obj);
+                benchmark::DoNotOptimize(three_fields(obj));
+            });
+        });
+        add("lazy/Wide200/stream/lazy", [=](benchmark::State& state) {
+            run(state, text->size(), 1, [&] {
+                stream::Lazy<Wide200> view(*text);
+                benchmark::DoNotOptimize(view_three_fields(view));
+            });
+        });
+    }
+
+    const bool registered = [] {
+        add_dom<jsoncpp::Traits>("jsoncpp");
+        add_dom<nlohmannjson::Traits>("nlohmann");
+        add_stream();
+        return true;
+    }();
+}
+}
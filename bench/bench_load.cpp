@@ -0,0 +1,54 @@
+// Loading an NDJSON file of ServerConfig records: read into a std::string
+// and decode, against decoding the mapped file in place.
+
+#include "datasets.hpp"
+
+#include <jsonstruct/load.hpp>
+#include <jsonstruct/stream_writer.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace bench {
+namespace {
+
+    constexpr std::size_t nrecords = 100000;
+
+    const bool registered = [] {
+        const std::string path = (std::filesystem::temp_directory_path() / "bench_jsonstruct.ndjson").string();
+        std::size_t bytes = 0;
+        {
+            std::ofstream out(path, std::ios::binary);
+            for (const auto& config : servers(nrecords)) {
+                const std::string line = stream::to_json_string(config);
+                out << line << '\n';
+                bytes += line.size() + 1;
+            }
+        }
+        static const struct Cleanup {
+            std::string path;
+            ~Cleanup() { std::remove(path.c_str()); }
+        } cleanup{path};
+
+        stream::BatchOptions options;
+        options.threads = 1;
+        add("load/ndjson/servers/ifstream", [=](benchmark::State& state) {
+            run(state, bytes, nrecords, [&] {
+                std::ifstream ifs(path, std::ios::binary);
+                const std::string text(std::istreambuf_iterator<char>(ifs), {});
+                auto result = stream::decode_ndjson<ServerConfig>(text, options);
+                benchmark::DoNotOptimize(result.records.data());
+            });
+        })->UseRealTime();
+        add("load/ndjson/servers/mmap", [=](benchmark::State& state) {
+            run(state, bytes, nrecords, [&] {
+                auto result = load_batch<ServerConfig>(path, options);
+                benchmark::DoNotOptimize(result.records.data());
+            });
+        })->UseRealTime();
+        return true;
+    }();
+}
+}
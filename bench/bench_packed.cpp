@@ -0,0 +1,70 @@
+// Streams of identical records: the schema-compiled packed layout against
+// CBOR, which repeats every key in every record.  wire_bytes is the size of
+// each encoding.
+
+#include "datasets.hpp"
+
+#include <jsonstruct/cbor.hpp>
+#include <jsonstruct/packed.hpp>
+
+#include <memory>
+
+namespace bench {
+namespace {
+
+    template<typename T>
+    void add_records(const std::string& dataset, std::vector<T> records) {
+        auto shared = std::make_shared<const std::vector<T>>(std::move(records));
+        auto packed_bytes = std::make_shared<const std::vector<std::uint8_t>>(packed::pack(*shared));
+        auto cbor_bytes = std::make_shared<const std::vector<std::uint8_t>>(cbor::to_cbor(*shared));
+        const std::size_t n = shared->size();
+
+        add("records/encode/" + dataset + "/packed", [=](benchmark::State& state) {
+            std::vector<std::uint8_t> out;
+            run(state, packed_bytes->size(), n, [&] {
+                out.clear();
+                packed::RecordWriter<T, std::vector<std::uint8_t>> writer(out);
+                for (const auto& record : *shared) writer.write(record);
+                benchmark::DoNotOptimize(out.data());
+            });
+            state.counters["wire_bytes"] = static_cast<double>(packed_bytes->size());
+        });
+        add("records/encode/" + dataset + "/cbor", [=](benchmark::State& state) {
+            std::vector<std::uint8_t> out;
+            run(state, cbor_bytes->size(), n, [&] {
+                out.clear();
+                cbor::write_cbor(*shared, out);
+                benchmark::DoNotOptimize(out.data());
+            });
+            state.counters["wire_bytes"] = static_cast<double>(cbor_bytes->size());
+        });
+        add("records/decode/" + dataset + "/packed", [=](benchmark::State& state) {
+            std::vector<T> out;
+            run(state, packed_bytes->size(), n, [&] {
+                benchmark::DoNotOptimize(packed::unpack(*packed_bytes, out));
+            });
+            state.counters["wire_bytes"] = static_cast<double>(packed_bytes->size());
+        });
+        add("records/decode/" + dataset + "/cbor", [=](benchmark::State& state) {
+            std::vector<T> out;
+            run(state, cbor_bytes->size(), n, [&] {
+                benchmark::DoNotOptimize(cbor::from_cbor(*cbor_bytes, out));
+            });
+            state.counters["wire_bytes"] = static_cast<double>(cbor_bytes->size());
+        });
+    }
+
+    std::vector<Point> points(std::size_t n) {
+        const auto xs = numbers<double>(2 * n);
+        std::vector<Point> out(n);
+        for (std::size_t i = 0; i < n; ++i) out[i] = Point{xs[2 * i], xs[2 * i + 1]};
+        return out;
+    }
+
+    const bool registered = [] {
+        add_records("servers", servers(1000));
+        add_records("points", points(10000));
+        return true;
+    }();
+}
+}
@@ -0,0 +1,81 @@
+// The cost of the instrumentation hooks decoding servers: plain Traits
+// (no hooks), profile::Traits with no Session (hooks which find nothing
+// to record into), and profile::Traits recording into a Profile.  Then
+// the same for the stream writer, through a plain and a profile::Sink.
+
+#include "datasets.hpp"
+
+#include <jsonstruct/jsoncpp.hpp>
+#include <jsonstruct/nlohmannjson.hpp>
+#include <jsonstruct/profile.hpp>
+#include <jsonstruct/stream_writer.hpp>
+
+#include <memory>
+
+namespace bench {
+namespace {
+
+    void count_allocations(std::uint64_t& allocations, std::uint64_t& bytes) {
+        allocations = allocation_count();
+        bytes = 0;
+    }
+
+    template<typename Traits>
+    void add_backend(const char* backend, const std::vector<ServerConfig>& records) {
+        using Profiled = profile::Traits<Traits>;
+        auto doc = std::make_shared<const typename Traits::ValueType>(
+            Converter<std::vector<ServerConfig>, Traits>::toJson(records));
+        add(std::string("profile/servers/") + backend + "/plain", [=](benchmark::State& state) {
+            std::vector<ServerConfig> out;
+            run(state, [&] {
+                benchmark::DoNotOptimize(Converter<std::vector<ServerConfig>, Traits>::fromJson(*doc, out));
+            });
+        });
+        add(std::string("profile/servers/") + backend + "/idle", [=](benchmark::State& state) {
+            std::vector<ServerConfig> out;
+            run(state, [&] {
+                benchmark::DoNotOptimize(Converter<std::vector<ServerConfig>, Profiled>::fromJson(*doc, out));
+            });
+        });
+        add(std::string("profile/servers/") + backend + "/recording", [=](benchmark::State& state) {
+            std::vector<ServerConfig> out;
+            profile::Profile stats(&count_allocations);
+            profile::Session session(stats);
+            run(state, [&] {
+                benchmark::DoNotOptimize(Converter<std::vector<ServerConfig>, Profiled>::fromJson(*doc, out));
+            });
+        });
+    }
+
+    void add_writer(const std::vector<ServerConfig>& records) {
+        auto shared = std::make_shared<const std::vector<ServerConfig>>(records);
+        add("profile/servers/stream/plain", [=](benchmark::State& state) {
+            std::string text;
+            run(state, [&] {
+                text.clear();
+                stream::write_json(*shared, text);
+                benchmark::DoNotOptimize(text.data());
+            });
+        });
+        add("profile/servers/stream/recording", [=](benchmark::State& state) {
+            std::string text;
+            profile::Profile stats(&count_allocations);
+            profile::Session session(stats);
+            run(state, [&] {
+                text.clear();
+                profile::Sink<std::string> sink(text);
+                stream::write_json(*shared, sink);
+                benchmark::DoNotOptimize(text.data());
+            });
+        });
+    }
+
+    const bool registered = [] {
+        const auto records = servers(1000);
+        add_backend<jsoncpp::Traits>("jsoncpp", records);
+        add_backend<nlohmannjson::Traits>("nlohmann", records);
+        add_writer(records);
+        return true;
+    }();
+}
+}
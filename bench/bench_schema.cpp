@@ -0,0 +1,59 @@
+// Turning away a malformed document: validate() against converting it
+// with fromJson(), which fills in and allocates everything before the
+// fault.  The fault is in the last record, so both go through the whole
+// document.  Also what validate() adds in front of fromJson() on a good one.
+
+#include "datasets.hpp"
+
+#include <jsonstruct/jsoncpp.hpp>
+#include <jsonstruct/nlohmannjson.hpp>
+#include <jsonstruct/schema.hpp>
+#include <jsonstruct/stream_writer.hpp>
+
+#include <memory>
+
+namespace bench {
+namespace {
+
+    constexpr std::size_t records = 1000;
+
+    template<typename Traits>
+    void add_backend(const char* backend) {
+        using Records = std::vector<ServerConfig>;
+        using Conv = Converter<Records, Traits>;
+        Records value = servers(records);
+        const std::size_t bytes = stream::to_json_string(value).size();
+        auto good = std::make_shared<const typename Traits::ValueType>(Conv::toJson(value));
+        value.back().db_config.max_connections = -1;
+        auto bad_doc = Conv::toJson(value);
+        bad_doc[static_cast<int>(records - 1)]["database"]["max_connections"] = "many";
+        auto bad = std::make_shared<const typename Traits::ValueType>(std::move(bad_doc));
+        const std::string prefix = std::string("schema/") + backend;
+
+        add(prefix + "/reject/fromJson", [=](benchmark::State& state) {
+            run(state, bytes, records, [&] {
+                Records out;
+                benchmark::DoNotOptimize(Conv::fromJson(*bad, out));
+            });
+        });
+        add(prefix + "/reject/validate", [=](benchmark::State& state) {
+            run(state, bytes, records, [&] { benchmark::DoNotOptimize(validate<Records, Traits>(*bad)); });
+        });
+        add(prefix + "/accept/fromJson", [=](benchmark::State& state) {
+            run(state, bytes, records, [&] {
+                Records out;
+                benchmark::DoNotOptimize(Conv::fromJson(*good, out));
+            });
+        });
+        add(prefix + "/accept/validate", [=](benchmark::State& state) {
+            run(state, bytes, records, [&] { benchmark::DoNotOptimize(validate<Records, Traits>(*good)); });
+        });
+    }
+
+    const bool registered = [] {
+        add_backend<jsoncpp::Traits>("jsoncpp");
+        add_backend<nlohmannjson::Traits>("nlohmann");
+        return true;
+    }();
+}
+}
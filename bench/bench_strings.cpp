@@ -0,0 +1,87 @@
+// String-heavy records decoded into fresh structs, with std::string fields
+// against std::string_view fields borrowing from the DOM or the text.
+
+#include "datasets.hpp"
+
+#include <jsonstruct/document.hpp>
+#include <jsonstruct/jsoncpp.hpp>
+#include <jsonstruct/nlohmannjson.hpp>
+#include <jsonstruct/stream_writer.hpp>
+
+#include <memory>
+
+namespace bench {
+namespace {
+
+    template<typename String>
+    struct Person {
+        String name;
+        String email;
+        String city;
+        std::vector<String> tags;
+
+        static auto config_fields() {
+            return std::make_tuple(make_field("name", &Person::name), make_field("email", &Person::email),
+                                   make_field("city", &Person::city), make_field("tags", &Person::tags));
+        }
+    };
+
+    using People = std::vector<Person<std::string>>;
+    using PeopleViews = std::vector<Person<std::string_view>>;
+
+    constexpr std::size_t npeople = 1000;
+
+    People people(std::size_t n) {
+        People out(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::string id = std::to_string(i);
+            out[i].name = "Person Number " + id + " Of The Dataset";
+            out[i].email = "person.number." + id + "@example.org";
+            out[i].city = i % 2 ? "Springfield, Somewhere" : "Shelbyville, Elsewhere";
+            out[i].tags = {"tag-alpha-" + id + "-long-enough", "tag-beta-" + id + "-long-enough"};
+        }
+        return out;
+    }
+
+    template<typename Traits>
+    void add_dom(const char* backend, const std::string& text) {
+        typename Traits::ValueType doc;
+        Traits::parse(text.data(), text.data() + text.size(), doc);
+        auto shared = std::make_shared<const typename Traits::ValueType>(std::move(doc));
+        const std::string prefix = std::string("strings/fromJson/") + backend;
+        add(prefix + "/string", [=](benchmark::State& state) {
+            run(state, text.size(), npeople, [&] {
+                People out;
+                benchmark::DoNotOptimize(Converter<People, Traits>::fromJson(*shared, out));
+            });
+        });
+        add(prefix + "/string_view", [=](benchmark::State& state) {
+            run(state, text.size(), npeople, [&] {
+                PeopleViews out;
+                benchmark::DoNotOptimize(Converter<PeopleViews, Traits>::fromJson(*shared, out));
+            });
+        });
+    }
+
+    const bool registered = [] {
+        auto text = std::make_shared<const std::string>(stream::to_json_string(people(npeople)));
+        const std::size_t bytes = text->size();
+        add_dom<jsoncpp::Traits>("jsoncpp", *text);
+        add_dom<nlohmannjson::Traits>("nlohmann", *text);
+        add("strings/fromJson/stream/string", [=](benchmark::State& state) {
+            run(state, bytes, npeople, [&] {
+                People out;
+                benchmark::DoNotOptimize(stream::from_json(*text, out));
+            });
+        });
+        add("strings/fromJson/stream/string_view", [=](benchmark::State& state) {
+            run(state, bytes, npeople, [&] {
+                Document doc = Document::borrow(*text);
+                PeopleViews out;
+                benchmark::DoNotOptimize(doc.decode(out));
+            });
+        });
+        return true;
+    }();
+}
+}
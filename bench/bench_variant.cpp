@@ -0,0 +1,84 @@
+// A 4-way variant whose last alternative matches: trying each alternative
+// in turn against a tagged variant which goes straight to it.
+
+#include "bench.hpp"
+
+#include <jsonstruct/jsoncpp.hpp>
+#include <jsonstruct/nlohmannjson.hpp>
+#include <jsonstruct/stream.hpp>
+#include <jsonstruct/stream_writer.hpp>
+
+#include <memory>
+
+namespace bench {
+namespace {
+
+    using namespace jsonstruct;
+
+    constexpr const char* variant_keys[] = {"alpha", "beta", "gamma", "delta"};
+
+    // Alternative K requires its own key, so only one of them can convert.
+    template<int K>
+    struct TrialAlt {
+        std::string name;
+        std::vector<double> samples;
+        static auto config_fields() {
+            return std::make_tuple(make_field(variant_keys[K], &TrialAlt::name),
+                                   make_field("samples", &TrialAlt::samples));
+        }
+    };
+
+    template<int K>
+    struct TaggedAlt : TrialAlt<K> {
+        static constexpr const char* json_tag = variant_keys[K];
+    };
+
+    using Trial = std::variant<TrialAlt<0>, TrialAlt<1>, TrialAlt<2>, TrialAlt<3>>;
+    using Tagged = std::variant<TaggedAlt<0>, TaggedAlt<1>, TaggedAlt<2>, TaggedAlt<3>>;
+
+    Tagged last_alternative(std::size_t nsamples) {
+        TaggedAlt<3> last;
+        last.name = "the last alternative";
+        last.samples = numbers<double>(nsamples);
+        return last;
+    }
+
+    template<typename Traits>
+    void add_dom(const char* backend, std::size_t nsamples) {
+        const Tagged src = last_alternative(nsamples);
+        auto doc = std::make_shared<const typename Traits::ValueType>(Converter<Tagged, Traits>::toJson(src));
+        const std::size_t bytes = stream::json_size(src);
+        const std::string name = std::string("variant/") + backend + "/samples:" + std::to_string(nsamples);
+        add(name + "/trial", [=](benchmark::State& state) {
+            Trial out;
+            run(state, bytes, 1, [&] { benchmark::DoNotOptimize(Converter<Trial, Traits>::fromJson(*doc, out)); });
+        });
+        add(name + "/tagged", [=](benchmark::State& state) {
+            Tagged out;
+            run(state, bytes, 1, [&] { benchmark::DoNotOptimize(Converter<Tagged, Traits>::fromJson(*doc, out)); });
+        });
+    }
+
+    void add_stream(std::size_t nsamples) {
+        auto text = std::make_shared<const std::string>(stream::to_json_string(last_alternative(nsamples)));
+        const std::string name = "variant/stream/samples:" + std::to_string(nsamples);
+        add(name + "/trial", [=](benchmark::State& state) {
+            Trial out;
+            run(state, text->size(), 1, [&] { benchmark::DoNotOptimize(stream::from_json(*text, out)); });
+        });
+        add(name + "/tagged", [=](benchmark::State& state) {
+            Tagged out;
+            run(state, text->size(), 1, [&] { benchmark::DoNotOptimize(stream::from_json(*text, out)); });
+        });
+    }
+
+    const bool registered = [] {
+        for (std::size_t n : {10, 1000}) {
+            add_dom<jsoncpp::Traits>("jsoncpp", n);
+            add_dom<nlohmannjson::Traits>("nlohmann", n);
+            add_stream(n);
+        }
+        return true;
+    }();
+}
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+// Generated inputs for bench_jsonstruct.  Each dataset is a C++ value; the
+// benchmarks derive its JsonCPP and nlohmann DOMs and its JSON text from it.
+
+#include "bench.hpp"
+
+#include <jsonstruct/converter.hpp>
+
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace bench {
+
+    using namespace jsonstruct;
+
+    // ServerConfig as shipped in test_jsonstruct.cpp.
+    struct ServerConfig {
+        std::string host = "localhost";
+        int port = 8080;
+        std::optional<bool> debug_mode;
+        std::variant<bool, std::string> feature_activation;
+        struct DatabaseConfig {
+            std::string user = "user";
+            std::string password = "changme";
+            int max_connections = 42;
+
+            static auto config_fields() {
+                return std::make_tuple(
+                    make_field("user", &DatabaseConfig::user),
+                    make_field("password", &DatabaseConfig::password, std::string("")),
+                    make_field("max_connections", &DatabaseConfig::max_connections, 10)
+                );
+            }
+        };
+        DatabaseConfig db_config;
+
+        std::vector<std::string> allowed_ips = { "127.0.0.1" };
+
+        static auto config_fields() {
+            return std::make_tuple(
+                make_field("host", &ServerConfig::host, std::string("localhost")),
+                make_field("port", &ServerConfig::port, 8080),
+                make_field("debug_mode", &ServerConfig::debug_mode),
+                make_field("feature_activation", &ServerConfig::feature_activation, std::variant<bool, std::string>(true)),
+                make_field("database", &ServerConfig::db_config),
+                make_field("allowed_ips", &ServerConfig::allowed_ips, std::vector<std::string>{})
+            );
+        }
+    };
+
+    inline std::vector<ServerConfig> servers(std::size_t n) {
+        std::vector<ServerConfig> out(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::string id = std::to_string(i);
+            out[i].host = "server-" + id + ".example.org";
+            out[i].port = 8000 + static_cast<int>(i % 1000);
+            if (i % 3 == 0) out[i].debug_mode = i % 2 == 0;
+            if (i % 2 == 0) out[i].feature_activation = "feature-" + id;
+            out[i].db_config.user = "user-" + id;
+            out[i].allowed_ips = {"10.0.0." + std::to_string(i % 256), "192.168.0." + std::to_string(i % 256)};
+        }
+        return out;
+    }
+
+    // Deep nesting: a chain of nodes, each holding the next.
+    struct Node {
+        int value = 0;
+        std::vector<Node> children;
+
+        static auto config_fields() {
+            return std::make_tuple(make_field("value", &Node::value),
+                                   make_field("children", &Node::children, std::vector<Node>{}));
+        }
+    };
+
+    inline Node chain(int depth) {
+        Node root;
+        Node* node = &root;
+        for (int i = 1; i < depth; ++i) {
+            node->value = i;
+            node->children.emplace_back();
+            node = &node->children.back();
+        }
+        return root;
+    }
+
+    // Variant-heavy: a mix which the JSON kind alone tells apart ...
+    struct Point {
+        double x = 0;
+        double y = 0;
+        static auto config_fields() {
+            return std::make_tuple(make_field("x", &Point::x), make_field("y", &Point::y));
+        }
+    };
+
+    using Mixed = std::variant<int, std::string, std::vector<double>, Point>;
+
+    inline std::vector<Mixed> mixed(std::size_t n) {
+        std::vector<Mixed> out;
+        out.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            switch (i % 4) {
+            case 0: out.emplace_back(static_cast<int>(i)); break;
+            case 1: out.emplace_back("label-" + std::to_string(i)); break;
+            case 2: out.emplace_back(std::vector<double>{0.5 * i, 1.5, 2.5}); break;
+            default: out.emplace_back(Point{1.0 * i, -1.0 * i}); break;
+            }
+        }
+        return out;
+    }
+
+    // ... and objects which only a tag tells apart.
+    struct Circle {
+        static constexpr const char* json_tag = "circle";
+        Point center;
+        double radius = 1;
+        static auto config_fields() {
+            return std::make_tuple(make_field("center", &Circle::center), make_field("radius", &Circle::radius));
+        }
+    };
+
+    struct Rect {
+        static constexpr const char* json_tag = "rect";
+        Point corner;
+        double width = 1;
+        double height = 1;
+        static auto config_fields() {
+            return std::make_tuple(make_field("corner", &Rect::corner), make_field("width", &Rect::width),
+                                   make_field("height", &Rect::height));
+        }
+    };
+
+    struct Polygon {
+        static constexpr const char* json_tag = "polygon";
+        std::vector<Point> points;
+        static auto config_fields() { return std::make_tuple(make_field("points", &Polygon::points)); }
+    };
+
+    using Shape = std::variant<Circle, Rect, Polygon>;
+
+    inline std::vector<Shape> shapes(std::size_t n) {
+        std::vector<Shape> out;
+        out.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const double d = static_cast<double>(i);
+            switch (i % 3) {
+            case 0: out.emplace_back(Circle{{d, d}, 2.0}); break;
+            case 1: out.emplace_back(Rect{{d, 0}, 3.0, 4.0}); break;
+            default: out.emplace_back(Polygon{{{0, 0}, {d, 0}, {0, d}}}); break;
+            }
+        }
+        return out;
+    }
+}
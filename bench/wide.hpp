@@ -0,0 +1,60 @@
+#pragma once
+
+// Wide structs of int fields f00, f01, ... for the struct member matching
+// benchmarks.
+
+#include <jsonstruct/converter.hpp>
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+
+namespace bench {
+
+    using namespace jsonstruct;
+
+#define BENCH_F10(X, p) X(p##0) X(p##1) X(p##2) X(p##3) X(p##4) X(p##5) X(p##6) X(p##7) X(p##8) X(p##9)
+#define BENCH_F50(X, p) BENCH_F10(X, p##0) BENCH_F10(X, p##1) BENCH_F10(X, p##2) BENCH_F10(X, p##3) BENCH_F10(X, p##4)
+#define BENCH_F100(X, p) BENCH_F50(X, p) BENCH_F10(X, p##5) BENCH_F10(X, p##6) BENCH_F10(X, p##7) BENCH_F10(X, p##8) BENCH_F10(X, p##9)
+
+#define BENCH_MEMBER(n) int n = 0;
+#define BENCH_FIELD(n) , make_field(#n, &Self::n, 0)
+
+#define BENCH_WIDE(Name, LIST)                                          \
+    struct Name {                                                       \
+        using Self = Name;                                              \
+        int id = 0;                                                     \
+        LIST(BENCH_MEMBER)                                              \
+        static auto config_fields() {                                   \
+            return std::make_tuple(make_field("id", &Self::id) LIST(BENCH_FIELD)); \
+        }                                                               \
+    };
+
+#define BENCH_LIST2(X) X(f0) X(f1)
+#define BENCH_LIST10(X) BENCH_F10(X, f)
+#define BENCH_LIST50(X) BENCH_F50(X, f)
+#define BENCH_LIST100(X) BENCH_F100(X, f)
+#define BENCH_LIST200(X) BENCH_F100(X, f) BENCH_F100(X, g)
+
+    BENCH_WIDE(Wide2, BENCH_LIST2)
+    BENCH_WIDE(Wide10, BENCH_LIST10)
+    BENCH_WIDE(Wide50, BENCH_LIST50)
+    BENCH_WIDE(Wide100, BENCH_LIST100)
+    BENCH_WIDE(Wide200, BENCH_LIST200)
+
+    // A document with every `stride`-th field of T present, plus "id" and
+    // `unknown` members which T does not declare.
+    template<typename JsonValue, typename T>
+    JsonValue wide_document(std::size_t stride, std::size_t unknown) {
+        JsonValue doc;
+        doc["id"] = 1;
+        std::size_t i = 0;
+        std::apply([&](const auto&... field) {
+            ((i++ % stride == 0 ? (doc[field.name] = 7, 0) : 0), ...);
+        }, field_table<T>());
+        for (std::size_t u = 0; u < unknown; ++u) {
+            doc["x" + std::to_string(u)] = 0;
+        }
+        return doc;
+    }
+}
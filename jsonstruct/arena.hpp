@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+namespace jsonstruct {
+
+    /// Construct a T with alloc by the uses-allocator rules: leading
+    /// std::allocator_arg, trailing allocator, or no allocator at all for
+    /// types which do not use one.  (std::make_obj_using_allocator is C++20.)
+    template<typename T, typename Alloc, typename... Args>
+    T make_using_allocator(const Alloc& alloc, Args&&... args) {
+        if constexpr (!std::uses_allocator_v<T, Alloc>) {
+            return T(std::forward<Args>(args)...);
+        } else if constexpr (std::is_constructible_v<T, std::allocator_arg_t, const Alloc&, Args...>) {
+            return T(std::allocator_arg, alloc, std::forward<Args>(args)...);
+        } else {
+            return T(std::forward<Args>(args)..., alloc);
+        }
+    }
+
+    /// A monotonic arena to decode whole messages into.
+    ///
+    /// Values made by make() take their memory from the arena: a std::pmr
+    /// container directly, and the strings, elements and nested structs in
+    /// it by uses-allocator construction.  The converters fill values in
+    /// place, so decoding into such a value with any backend allocates only
+    /// from the arena, and release() frees all of it at once.
+    ///
+    /// A struct takes part by declaring itself allocator-aware:
+    ///
+    ///   struct Config {
+    ///       using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+    ///       std::pmr::string host;
+    ///       std::pmr::vector<std::pmr::string> ips;
+    ///       Config(const allocator_type& a = {}) : host(a), ips(a) {}
+    ///       Config(const Config& o, const allocator_type& a) : host(o.host, a), ips(o.ips, a) {}
+    ///       ...
+    ///   };
+    ///
+    /// Values must not outlive the arena, nor be used after release().
+    class Arena {
+    public:
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+        explicit Arena(std::size_t initial_size = 4096,
+                       std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : resource_(initial_size, upstream) {}
+
+        /// Allocate from buffer first, then from upstream.
+        Arena(void* buffer, std::size_t size,
+              std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : resource_(buffer, size, upstream) {}
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        std::pmr::memory_resource* resource() { return &resource_; }
+        allocator_type allocator() { return allocator_type(&resource_); }
+
+        /// A T whose memory comes from the arena.
+        template<typename T, typename... Args>
+        T make(Args&&... args) {
+            return make_using_allocator<T>(allocator(), std::forward<Args>(args)...);
+        }
+
+        /// Free everything allocated so far, in O(1) regardless of how
+        /// many values were decoded.
+        void release() { resource_.release(); }
+
+    private:
+        std::pmr::monotonic_buffer_resource resource_;
+    };
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <jsonstruct/stream.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace jsonstruct::stream {
+
+    /// A record which failed to decode.  offset is where the record starts
+    /// in the input, position where decoding stopped.  code and path are
+    /// the record's last_error(), path being relative to the record;
+    /// Errc::unreadable, at index 0, if the input file could not be read.
+    struct RecordError {
+        std::size_t index;
+        std::size_t offset;
+        std::size_t position;
+        Errc code = Errc::syntax;
+        std::string path;
+    };
+
+    /// One element per record, in input order.  Records listed in errors
+    /// (by ascending index) hold whatever was decoded before the failure.
+    template<typename T>
+    struct BatchResult {
+        std::vector<T> records;
+        std::vector<RecordError> errors;
+
+        bool ok() const { return errors.empty(); }
+    };
+
+    struct BatchOptions {
+        /// Worker threads; 0 means std::thread::hardware_concurrency().
+        unsigned threads = 0;
+        /// Records handed to a worker at a time.
+        std::size_t chunk_records = 256;
+    };
+
+    /// The byte range of one record in the input.
+    struct RecordSpan {
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    /// Split newline-delimited JSON into records.  Lines holding only
+    /// whitespace are not records.  A JSON text can not contain a raw
+    /// newline, even inside a string, so every newline is a boundary.
+    inline std::vector<RecordSpan> split_ndjson(std::string_view text) {
+        std::vector<RecordSpan> spans;
+        std::size_t start = 0;
+        while (start < text.size()) {
+            const void* nl = std::memchr(text.data() + start, '\n', text.size() - start);
+            const std::size_t end = nl ? static_cast<std::size_t>(static_cast<const char*>(nl) - text.data()) : text.size();
+            for (std::size_t p = start; p < end; ++p) {
+                const char c = text[p];
+                if (c != ' ' && c != '\t' && c != '\r') {
+                    spans.push_back({start, end - start});
+                    break;
+                }
+            }
+            start = end + 1;
+        }
+        return spans;
+    }
+
+    /// Split a top-level JSON array into its elements.  Only brackets,
+    /// braces, commas and strings are looked at; each element is validated
+    /// when it is decoded.  Returns false if text is not an array.
+    inline bool split_array(std::string_view text, std::vector<RecordSpan>& spans) {
+        spans.clear();
+        std::size_t p = 0;
+        auto skip_ws = [&] {
+            while (p < text.size() && (text[p] == ' ' || text[p] == '\n' || text[p] == '\r' || text[p] == '\t')) ++p;
+        };
+        skip_ws();
+        if (p == text.size() || text[p] != '[') return false;
+        ++p;
+        std::size_t start = p;
+        int depth = 0;
+        bool any = false;
+        for (; p < text.size(); ++p) {
+            const char c = text[p];
+            if (c == '"') {
+                for (++p; p < text.size() && text[p] != '"'; ++p) {
+                    if (text[p] == '\\') ++p;
+                }
+                any = true;
+            } else if (c == '[' || c == '{') {
+                ++depth;
+                any = true;
+            } else if (c == ']' || c == '}') {
+                if (depth == 0) {
+                    if (c != ']') return false;
+                    if (any || !spans.empty()) spans.push_back({start, p - start});
+                    ++p;
+                    skip_ws();
+                    return p == text.size();
+                }
+                --depth;
+            } else if (c == ',' && depth == 0) {
+                spans.push_back({start, p - start});
+                start = p + 1;
+                any = false;
+            } else if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+                any = true;
+            }
+        }
+        return false;
+    }
+
+    /// Decode the records of text at spans into a vector, on
+    /// options.threads threads.  Workers take chunks of records in turn and
+    /// decode each straight into its place, so the order is the input's.
+    template<typename T>
+    BatchResult<T> decode_records(std::string_view text, const std::vector<RecordSpan>& spans,
+                                  const BatchOptions& options = {}) {
+        BatchResult<T> result;
+        result.records.resize(spans.size());
+        const std::size_t chunk = std::max<std::size_t>(options.chunk_records, 1);
+        const std::size_t nchunks = (spans.size() + chunk - 1) / chunk;
+        std::vector<std::vector<RecordError>> chunk_errors(nchunks);
+        std::atomic<std::size_t> next{0};
+
+        auto work = [&] {
+            for (std::size_t c = next.fetch_add(1); c < nchunks; c = next.fetch_add(1)) {
+                const std::size_t end = std::min(spans.size(), (c + 1) * chunk);
+                for (std::size_t i = c * chunk; i < end; ++i) {
+                    Reader in(text.data() + spans[i].offset, spans[i].size);
+                    if (!Decoder<T>::decode(in, result.records[i])) {
+                        const Error& error = last_error();
+                        chunk_errors[c].push_back({i, spans[i].offset, spans[i].offset + in.position(),
+                                                   error.code(), error.path()});
+                    } else if (!in.at_end()) {
+                        chunk_errors[c].push_back({i, spans[i].offset, spans[i].offset + in.position(),
+                                                   Errc::syntax, std::string()});
+                    }
+                }
+            }
+        };
+
+        unsigned nthreads = options.threads ? options.threads : std::thread::hardware_concurrency();
+        nthreads = static_cast<unsigned>(std::min<std::size_t>(std::max(nthreads, 1u), std::max<std::size_t>(nchunks, 1)));
+        std::vector<std::thread> workers;
+        workers.reserve(nthreads - 1);
+        for (unsigned t = 1; t < nthreads; ++t) workers.emplace_back(work);
+        work();
+        for (auto& worker : workers) worker.join();
+
+        for (auto& errors : chunk_errors) {
+            result.errors.insert(result.errors.end(), errors.begin(), errors.end());
+        }
+        return result;
+    }
+
+    /// Decode newline-delimited JSON, one T per non-blank line.
+    template<typename T>
+    BatchResult<T> decode_ndjson(std::string_view text, const BatchOptions& options = {}) {
+        return decode_records<T>(text, split_ndjson(text), options);
+    }
+
+    /// Decode a top-level JSON array, one T per element.  If text is not
+    /// an array there are no records and one error, at index 0.
+    template<typename T>
+    BatchResult<T> decode_array(std::string_view text, const BatchOptions& options = {}) {
+        std::vector<RecordSpan> spans;
+        if (!split_array(text, spans)) {
+            BatchResult<T> result;
+            result.errors.push_back({0, 0, 0, Errc::syntax, std::string()});
+            return result;
+        }
+        return decode_records<T>(text, spans, options);
+    }
+
+    /// Decode an NDJSON file.  If it can not be read there are no records
+    /// and one error, at index 0.  The text is freed on return, so T must
+    /// not borrow from it (std::string_view members); read the file
+    /// yourself and use decode_ndjson(text), or load_batch() a MappedFile.
+    template<typename T>
+    BatchResult<T> decode_ndjson_file(const std::string& filename, const BatchOptions& options = {}) {
+        static_assert(!borrows_text<T>(),
+                      "the records would borrow from text freed on return; decode_ndjson() text you keep instead");
+        std::ifstream ifs(filename, std::ios::binary);
+        if (!ifs) {
+            BatchResult<T> result;
+            result.errors.push_back({0, 0, 0, Errc::unreadable, std::string()});
+            return result;
+        }
+        const std::string text(std::istreambuf_iterator<char>(ifs), {});
+        return decode_ndjson<T>(text, options);
+    }
+}
@@ -0,0 +1,932 @@
+#pragma once
+
+#include <jsonstruct/converter.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace jsonstruct::cbor {
+
+    /// A pull reader over one complete CBOR (RFC 8949) data item.
+    ///
+    /// Like the stream backend no DOM is built: the Decoder
+    /// specializations below pull items straight into the C++ value.
+    /// Numbers are read from their binary form, never parsed from text, and
+    /// strings are length-prefixed rather than escaped, so std::string_view
+    /// members always borrow straight from the input.  Arrays and maps may
+    /// have definite or indefinite length; strings must be definite.  Tags
+    /// are skipped.  The Reader never allocates and, as in the stream
+    /// backend, its state is a position so std::variant can backtrack.
+    class Reader {
+    public:
+        enum class Kind { null, boolean, integer, real, string, array, object, end, invalid };
+
+        /// Count of a container whose length is not given up front.
+        static constexpr std::size_t indefinite = std::numeric_limits<std::size_t>::max();
+
+        Reader(const std::uint8_t* data, std::size_t size) : data_(data), size_(size) {}
+        explicit Reader(const std::vector<std::uint8_t>& bytes) : Reader(bytes.data(), bytes.size()) {}
+
+        bool failed() const { return failed_; }
+        std::size_t position() const { return pos_; }
+
+        /// Return to an earlier position() and clear any failure.
+        void seek(std::size_t pos) { pos_ = pos; failed_ = false; }
+
+        /// Skip tags and classify the next item without consuming it.
+        Kind peek() {
+            if (!skip_tags()) return Kind::invalid;
+            if (pos_ >= size_) return Kind::end;
+            const std::uint8_t initial = data_[pos_];
+            switch (initial >> 5) {
+            case 0: case 1: return Kind::integer;
+            case 3: return Kind::string;
+            case 4: return Kind::array;
+            case 5: return Kind::object;
+            case 7:
+                switch (initial) {
+                case 0xf4: case 0xf5: return Kind::boolean;
+                case 0xf6: case 0xf7: return Kind::null;    // null, undefined
+                case 0xf9: case 0xfa: case 0xfb: return Kind::real;
+                default: return Kind::invalid;
+                }
+            default: return Kind::invalid;                  // byte strings
+            }
+        }
+
+        /// True if the whole input has been consumed.
+        bool at_end() const { return pos_ == size_; }
+
+        bool null() {
+            if (peek() != Kind::null) return fail();
+            ++pos_;
+            return true;
+        }
+
+        bool boolean(bool& val) {
+            if (peek() != Kind::boolean) return fail();
+            val = data_[pos_++] == 0xf5;
+            return true;
+        }
+
+        /// Consume an integer of any size CBOR holds: arg, or -1 - arg
+        /// when negative.
+        bool integer(std::uint64_t& arg, bool& negative) {
+            if (peek() != Kind::integer) return fail();
+            negative = (data_[pos_] >> 5) == 1;
+            bool indef;
+            return (head(arg, indef) && !indef) || fail();
+        }
+
+        /// Consume an integer which fits std::int64_t.
+        bool integer(std::int64_t& val) {
+            std::uint64_t arg;
+            bool negative;
+            if (!integer(arg, negative)) return false;
+            if (arg > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) return fail();
+            val = negative ? -1 - static_cast<std::int64_t>(arg) : static_cast<std::int64_t>(arg);
+            return true;
+        }
+
+        /// Consume a number of either kind, as a double.
+        bool real(double& val) {
+            const Kind k = peek();
+            if (k == Kind::integer) {
+                std::uint64_t arg;
+                bool negative;
+                if (!integer(arg, negative)) return false;
+                val = negative ? -1.0 - static_cast<double>(arg) : static_cast<double>(arg);
+                return true;
+            }
+            if (k != Kind::real) return fail();
+            const std::uint8_t initial = data_[pos_++];
+            if (initial == 0xf9) {
+                std::uint64_t bits;
+                if (!big_endian(2, bits)) return false;
+                val = half_to_double(static_cast<std::uint16_t>(bits));
+            } else if (initial == 0xfa) {
+                std::uint64_t bits;
+                if (!big_endian(4, bits)) return false;
+                const auto bits32 = static_cast<std::uint32_t>(bits);
+                float f;
+                std::memcpy(&f, &bits32, 4);
+                val = f;
+            } else {
+                std::uint64_t bits;
+                if (!big_endian(8, bits)) return false;
+                std::memcpy(&val, &bits, 8);
+            }
+            return true;
+        }
+
+        /// Consume a text string as a view into the input.
+        bool string(std::string_view& val) {
+            if (peek() != Kind::string) return fail();
+            std::uint64_t len;
+            bool indef;
+            if (!head(len, indef) || indef || len > size_ - pos_) return fail();
+            val = std::string_view(reinterpret_cast<const char*>(data_ + pos_), static_cast<std::size_t>(len));
+            pos_ += static_cast<std::size_t>(len);
+            return true;
+        }
+
+        /// Begin an array of count elements (or indefinite).  Follow with
+        /// next_element(count) until it returns false.
+        bool array_begin(std::size_t& count) { return peek() == Kind::array ? container(count) : fail(); }
+
+        /// Advance to the next element, if any remain.
+        bool next_element(std::size_t& count) { return next(count); }
+
+        /// Begin a map of count members (or indefinite).  Follow with
+        /// next_key(count, key) until it returns false.
+        bool object_begin(std::size_t& count) { return peek() == Kind::object ? container(count) : fail(); }
+
+        /// Advance to the next member, if any remain, and consume its key,
+        /// which must be a text string.
+        bool next_key(std::size_t& count, std::string_view& key) { return next(count) && string(key); }
+
+        /// True if the next item is an empty map or array.
+        bool empty_container() {
+            const std::size_t start = pos_;
+            const Kind k = peek();
+            bool empty = false;
+            std::size_t count;
+            if ((k == Kind::array || k == Kind::object) && container(count)) {
+                empty = count == 0 || (count == indefinite && pos_ < size_ && data_[pos_] == 0xff);
+            }
+            seek(start);
+            return empty;
+        }
+
+        /// Look ahead in the map which comes next for a member called name,
+        /// without consuming anything, and return its kind: end if there
+        /// is none.  A text string's value is read into value.
+        Kind find_member(std::string_view name, std::string_view& value) {
+            const std::size_t start = pos_;
+            Kind found = Kind::end;
+            std::size_t count;
+            if (object_begin(count)) {
+                std::string_view key;
+                while (next_key(count, key)) {
+                    if (key != name) {
+                        if (!skip()) break;
+                        continue;
+                    }
+                    found = peek();
+                    if (found == Kind::string && !string(value)) found = Kind::invalid;
+                    break;
+                }
+            }
+            seek(start);
+            return found;
+        }
+
+        /// Consume and discard the next item.
+        bool skip() { return skip_item(0); }
+
+    private:
+        static constexpr int max_depth = 512;
+
+        bool fail() { failed_ = true; return false; }
+
+        // Read n bytes as a big-endian unsigned integer.
+        bool big_endian(std::size_t n, std::uint64_t& val) {
+            if (n > size_ - pos_) return fail();
+            val = 0;
+            for (std::size_t i = 0; i < n; ++i) val = (val << 8) | data_[pos_ + i];
+            pos_ += n;
+            return true;
+        }
+
+        // Consume an initial byte and its argument: a count, length or
+        // integer value.  indef is set for the indefinite-length marker.
+        bool head(std::uint64_t& arg, bool& indef) {
+            if (pos_ >= size_) return fail();
+            const std::uint8_t info = data_[pos_++] & 0x1f;
+            indef = false;
+            if (info < 24) { arg = info; return true; }
+            switch (info) {
+            case 24: return big_endian(1, arg);
+            case 25: return big_endian(2, arg);
+            case 26: return big_endian(4, arg);
+            case 27: return big_endian(8, arg);
+            case 31: indef = true; return true;
+            default: return fail();
+            }
+        }
+
+        bool skip_tags() {
+            while (pos_ < size_ && (data_[pos_] >> 5) == 6) {
+                std::uint64_t tag;
+                bool indef;
+                if (!head(tag, indef) || indef) return fail();
+            }
+            return true;
+        }
+
+        bool container(std::size_t& count) {
+            std::uint64_t arg;
+            bool indef;
+            if (!head(arg, indef)) return false;
+            // Every element takes at least a byte, which bounds a definite count.
+            if (!indef && arg > size_ - pos_) return fail();
+            count = indef ? indefinite : static_cast<std::size_t>(arg);
+            return true;
+        }
+
+        bool next(std::size_t& count) {
+            if (count == indefinite) {
+                if (pos_ >= size_) return fail();
+                if (data_[pos_] != 0xff) return true;
+                ++pos_;
+                return false;
+            }
+            if (count == 0) return false;
+            --count;
+            return true;
+        }
+
+        static double half_to_double(std::uint16_t half) {
+            const int exp = (half >> 10) & 0x1f;
+            const int mant = half & 0x3ff;
+            double val;
+            if (exp == 0) val = std::ldexp(mant, -24);
+            else if (exp != 31) val = std::ldexp(mant + 1024, exp - 25);
+            else val = mant == 0 ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+            return half & 0x8000 ? -val : val;
+        }
+
+        bool skip_item(int depth) {
+            if (depth > max_depth) return fail();
+            std::size_t count;
+            switch (peek()) {
+            case Kind::null: return null();
+            case Kind::boolean: { bool b; return boolean(b); }
+            case Kind::integer: { std::uint64_t arg; bool indef; return head(arg, indef) && (!indef || fail()); }
+            case Kind::real: { double d; return real(d); }
+            case Kind::string: { std::string_view s; return string(s); }
+            case Kind::array:
+                if (!array_begin(count)) return false;
+                while (next_element(count)) {
+                    if (!skip_item(depth + 1)) return false;
+                }
+                return !failed_;
+            case Kind::object: {
+                if (!object_begin(count)) return false;
+                std::string_view key;
+                while (next_key(count, key)) {
+                    if (!skip_item(depth + 1)) return false;
+                }
+                return !failed_;
+            }
+            default: return fail();
+            }
+        }
+
+        const std::uint8_t* data_;
+        std::size_t size_;
+        std::size_t pos_{0};
+        bool failed_{false};
+    };
+
+
+    /// Emits CBOR items to a Sink, which is anything with
+    /// push_back(std::uint8_t) and insert(end(), first, last) such as
+    /// std::vector<std::uint8_t>.  Every head uses the shortest form and
+    /// containers have definite length, as RFC 8949's preferred
+    /// serialization asks.
+    template<typename Sink>
+    class Writer {
+    public:
+        explicit Writer(Sink& sink) : sink_(sink) {}
+
+        void null() { sink_.push_back(0xf6); }
+        void boolean(bool b) { sink_.push_back(b ? 0xf5 : 0xf4); }
+
+        void integer(std::int64_t i) {
+            if (i >= 0) head(0, static_cast<std::uint64_t>(i));
+            else head(1, static_cast<std::uint64_t>(-1 - i));
+        }
+
+        void unsigned_integer(std::uint64_t u) { head(0, u); }
+
+        /// As a single-precision float when that loses nothing.
+        void real(double d) {
+            // Converting a double beyond float's range is undefined.
+            const bool fits = std::isnan(d) || std::fabs(d) <= std::numeric_limits<float>::max();
+            const float f = fits ? static_cast<float>(d) : 0.0f;
+            if (fits && (static_cast<double>(f) == d || std::isnan(d))) {
+                std::uint32_t bits;
+                std::memcpy(&bits, &f, 4);
+                put(0xfa, bits, 4);
+            } else {
+                std::uint64_t bits;
+                std::memcpy(&bits, &d, 8);
+                put(0xfb, bits, 8);
+            }
+        }
+
+        void string(std::string_view s) {
+            head(3, s.size());
+            sink_.insert(sink_.end(), s.begin(), s.end());
+        }
+
+        void array_begin(std::size_t count) { head(4, count); }
+        void object_begin(std::size_t count) { head(5, count); }
+        void key(std::string_view name) { string(name); }
+
+    private:
+        void head(std::uint8_t major, std::uint64_t arg) {
+            const std::uint8_t m = static_cast<std::uint8_t>(major << 5);
+            if (arg < 24) sink_.push_back(static_cast<std::uint8_t>(m | arg));
+            else if (arg <= 0xff) put(m | 24, arg, 1);
+            else if (arg <= 0xffff) put(m | 25, arg, 2);
+            else if (arg <= 0xffffffff) put(m | 26, arg, 4);
+            else put(m | 27, arg, 8);
+        }
+
+        // An initial byte followed by n bytes of val, big-endian.
+        void put(std::uint8_t initial, std::uint64_t val, std::size_t n) {
+            std::array<std::uint8_t, 9> buf;
+            buf[0] = initial;
+            for (std::size_t i = 0; i < n; ++i) buf[n - i] = static_cast<std::uint8_t>(val >> (8 * i));
+            sink_.insert(sink_.end(), buf.begin(), buf.begin() + 1 + n);
+        }
+
+        Sink& sink_;
+    };
+
+
+    /// Decode the next item from a Reader into a C++ value.  Mirrors
+    /// jsonstruct::Converter<T, JsonLibTraits>::fromJson, one specialization
+    /// per supported type.
+    template<typename T, typename Enable = void>
+    struct Decoder;
+
+    /// Write a C++ value to a Writer.  Mirrors
+    /// jsonstruct::Converter<T, JsonLibTraits>::toJson.
+    template<typename T, typename Enable = void>
+    struct Encoder;
+
+    // Record why the item at start, expected to be of kind expected, could
+    // not be read: it is some other kind, or it is malformed.  Takes a copy
+    // of the Reader to look back with.  Returns false.
+    inline bool fail_read(Reader in, std::size_t start, Reader::Kind expected) {
+        in.seek(start);
+        return fail(in.peek() == expected ? Errc::syntax : Errc::type_mismatch);
+    }
+
+    // Every integral type but bool, range checked: an integer the type can
+    // not hold is out_of_range.
+    template<typename Num>
+    struct Decoder<Num, std::enable_if_t<is_number_type<Num>::value && std::is_integral_v<Num>>> {
+        static bool decode(Reader& in, Num& cpp_val) {
+            const std::size_t start = in.position();
+            std::uint64_t arg;
+            bool negative;
+            if (!in.integer(arg, negative)) return fail_read(in, start, Reader::Kind::integer);
+            if (!negative) return narrow(arg, cpp_val);
+            // -1 - arg fits a signed Num exactly when arg fits.
+            if (!std::is_signed_v<Num> || !fits<Num>(arg)) return fail(Errc::out_of_range);
+            cpp_val = static_cast<Num>(-1 - static_cast<std::int64_t>(arg));
+            return true;
+        }
+    };
+
+    template<typename Num>
+    struct Encoder<Num, std::enable_if_t<is_number_type<Num>::value && std::is_integral_v<Num>>> {
+        template<typename Writer>
+        static void encode(Writer& out, const Num& cpp_val) {
+            if constexpr (std::is_signed_v<Num>) out.integer(cpp_val);
+            else out.unsigned_integer(cpp_val);
+        }
+    };
+
+    // float, double and long double.  Integers are accepted too, like
+    // JsonCPP's isDouble(); a value beyond a float's range is out_of_range.
+    template<typename Num>
+    struct Decoder<Num, std::enable_if_t<std::is_floating_point_v<Num>>> {
+        static bool decode(Reader& in, Num& cpp_val) {
+            const std::size_t start = in.position();
+            double val;
+            if (in.real(val)) return narrow(val, cpp_val);
+            Reader probe = in;
+            probe.seek(start);
+            const Reader::Kind kind = probe.peek();
+            return fail(kind == Reader::Kind::integer || kind == Reader::Kind::real ? Errc::syntax : Errc::type_mismatch);
+        }
+    };
+
+    // A float is written as a single-precision float, which loses nothing.
+    template<typename Num>
+    struct Encoder<Num, std::enable_if_t<std::is_floating_point_v<Num>>> {
+        template<typename Writer>
+        static void encode(Writer& out, const Num& cpp_val) { out.real(static_cast<double>(cpp_val)); }
+    };
+
+    // Enums by name, or by the underlying integer (see enum.hpp).
+    template<typename E>
+    struct Decoder<E, std::enable_if_t<has_enum_names<E>::value>> {
+        static bool decode(Reader& in, E& cpp_val) {
+            if (in.peek() == Reader::Kind::string) {
+                const std::size_t start = in.position();
+                std::string_view name;
+                if (!in.string(name)) return fail_read(in, start, Reader::Kind::string);
+                return enum_from_name(name, cpp_val);
+            }
+            std::underlying_type_t<E> bits{};
+            if (!Decoder<std::underlying_type_t<E>>::decode(in, bits)) return false;
+            cpp_val = static_cast<E>(bits);
+            return true;
+        }
+    };
+
+    template<typename E>
+    struct Encoder<E, std::enable_if_t<has_enum_names<E>::value>> {
+        template<typename Writer>
+        static void encode(Writer& out, const E& cpp_val) {
+            if (const char* name = EnumNames<E>::name(cpp_val)) out.string(name);
+            else Encoder<std::underlying_type_t<E>>::encode(out, static_cast<std::underlying_type_t<E>>(cpp_val));
+        }
+    };
+
+    // Flag sets, as an array of names and integers.
+    template<typename E>
+    struct Decoder<E, std::enable_if_t<has_flag_names<E>::value>> {
+        static bool decode(Reader& in, E& cpp_val) {
+            using Underlying = std::underlying_type_t<E>;
+            std::size_t start = in.position();
+            std::size_t count;
+            if (!in.array_begin(count)) return fail_read(in, start, Reader::Kind::array);
+            Underlying bits = 0;
+            for (std::size_t index = 0; in.next_element(count); ++index) {
+                Underlying more = 0;
+                bool ok;
+                if (in.peek() == Reader::Kind::string) {
+                    start = in.position();
+                    std::string_view name;
+                    ok = in.string(name) ? add_flag<E>(name, more) : fail_read(in, start, Reader::Kind::string);
+                } else {
+                    ok = Decoder<Underlying>::decode(in, more);
+                }
+                if (!ok) return fail_in(index);
+                bits |= more;
+            }
+            if (in.failed()) return fail(Errc::syntax);
+            cpp_val = static_cast<E>(bits);
+            return true;
+        }
+    };
+
+    template<typename E>
+    struct Encoder<E, std::enable_if_t<has_flag_names<E>::value>> {
+        template<typename Writer>
+        static void encode(Writer& out, const E& cpp_val) {
+            using Underlying = std::underlying_type_t<E>;
+            // The count comes first, so the names are gone over twice.
+            std::size_t count = 0;
+            const Underlying rest = EnumNames<E>::for_each_flag(cpp_val, [&](const char*) { ++count; });
+            out.array_begin(count + (rest ? 1 : 0));
+            EnumNames<E>::for_each_flag(cpp_val, [&](const char* name) { out.string(name); });
+            if (rest) Encoder<Underlying>::encode(out, rest);
+        }
+    };
+
+    template<>
+    struct Decoder<bool, void> {
+        static bool decode(Reader& in, bool& cpp_val) {
+            const std::size_t start = in.position();
+            return in.boolean(cpp_val) || fail_read(in, start, Reader::Kind::boolean);
+        }
+    };
+
+    template<>
+    struct Encoder<bool, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const bool& cpp_val) { out.boolean(cpp_val); }
+    };
+
+    // Points into the input, which must outlive it.
+    template<>
+    struct Decoder<std::string_view, void> {
+        static bool decode(Reader& in, std::string_view& cpp_val) {
+            const std::size_t start = in.position();
+            return in.string(cpp_val) || fail_read(in, start, Reader::Kind::string);
+        }
+    };
+
+    template<>
+    struct Encoder<std::string_view, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const std::string_view& cpp_val) { out.string(cpp_val); }
+    };
+
+    template<typename Alloc>
+    struct Decoder<std::basic_string<char, std::char_traits<char>, Alloc>, void> {
+        static bool decode(Reader& in, std::basic_string<char, std::char_traits<char>, Alloc>& cpp_val) {
+            const std::size_t start = in.position();
+            std::string_view s;
+            if (!in.string(s)) return fail_read(in, start, Reader::Kind::string);
+            cpp_val.assign(s.data(), s.size());
+            return true;
+        }
+    };
+
+    template<typename Alloc>
+    struct Encoder<std::basic_string<char, std::char_traits<char>, Alloc>, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const std::basic_string<char, std::char_traits<char>, Alloc>& cpp_val) {
+            out.string(cpp_val);
+        }
+    };
+
+    // Shared by the sequence containers: vector, deque.  The element count
+    // is known up front, so a vector is reserved once, and a std::vector of
+    // numbers is sized once and filled in place.
+    template<typename Container>
+    struct SequenceDecoder {
+        using T_elem = typename Container::value_type;
+        static bool decode(Reader& in, Container& cpp_val) {
+            const std::size_t start = in.position();
+            std::size_t count;
+            if (!in.array_begin(count)) return fail_read(in, start, Reader::Kind::array);
+            if constexpr (is_bulk_number<T_elem>::value && has_data<Container>::value) {
+                if (count != Reader::indefinite) {
+                    cpp_val.resize(count);
+                    for (std::size_t i = 0; i < count; ++i) {
+                        if (!Decoder<T_elem>::decode(in, cpp_val[i])) return fail_in(i);
+                    }
+                    return true;
+                }
+            }
+            cpp_val.clear();
+            if constexpr (has_reserve<Container>::value) {
+                if (count != Reader::indefinite) cpp_val.reserve(count);
+            }
+            while (in.next_element(count)) {
+                if constexpr (std::is_same_v<T_elem, bool>) {
+                    bool elem;
+                    if (!Decoder<bool>::decode(in, elem)) return fail_in(cpp_val.size());
+                    cpp_val.push_back(elem);
+                } else {
+                    cpp_val.emplace_back();
+                    if (!Decoder<T_elem>::decode(in, cpp_val.back())) return fail_in(cpp_val.size() - 1);
+                }
+            }
+            return !in.failed() || fail(Errc::syntax);
+        }
+
+    private:
+        template<typename C, typename = void>
+        struct has_reserve : std::false_type {};
+        template<typename C>
+        struct has_reserve<C, std::void_t<decltype(std::declval<C&>().reserve(std::size_t{}))>> : std::true_type {};
+    };
+
+    // Shared by the sequence containers: vector, deque, array.
+    template<typename Container>
+    struct SequenceEncoder {
+        template<typename Writer>
+        static void encode(Writer& out, const Container& cpp_val) {
+            out.array_begin(cpp_val.size());
+            for (const auto& elem : cpp_val) {
+                Encoder<typename Container::value_type>::encode(out, elem);
+            }
+        }
+    };
+
+    template<typename T_elem, typename Alloc>
+    struct Decoder<std::vector<T_elem, Alloc>, void> : SequenceDecoder<std::vector<T_elem, Alloc>> {};
+
+    template<typename T_elem, typename Alloc>
+    struct Encoder<std::vector<T_elem, Alloc>, void> : SequenceEncoder<std::vector<T_elem, Alloc>> {};
+
+    template<typename T_elem, typename Alloc>
+    struct Decoder<std::deque<T_elem, Alloc>, void> : SequenceDecoder<std::deque<T_elem, Alloc>> {};
+
+    template<typename T_elem, typename Alloc>
+    struct Encoder<std::deque<T_elem, Alloc>, void> : SequenceEncoder<std::deque<T_elem, Alloc>> {};
+
+    template<typename T_elem, std::size_t N>
+    struct Decoder<std::array<T_elem, N>, void> {
+        static bool decode(Reader& in, std::array<T_elem, N>& cpp_val) {
+            const std::size_t start = in.position();
+            std::size_t count;
+            if (!in.array_begin(count)) return fail_read(in, start, Reader::Kind::array);
+            std::size_t i = 0;
+            while (in.next_element(count)) {
+                if (i == N) return fail(Errc::type_mismatch);
+                if (!Decoder<T_elem>::decode(in, cpp_val[i])) return fail_in(i);
+                ++i;
+            }
+            if (in.failed()) return fail(Errc::syntax);
+            return i == N || fail(Errc::type_mismatch);
+        }
+    };
+
+    template<typename T_elem, std::size_t N>
+    struct Encoder<std::array<T_elem, N>, void> : SequenceEncoder<std::array<T_elem, N>> {};
+
+    // Shared by the string-keyed maps.
+    template<typename Map>
+    struct MapDecoder {
+        static bool decode(Reader& in, Map& cpp_val) {
+            const std::size_t start = in.position();
+            std::size_t count;
+            if (!in.object_begin(count)) return fail_read(in, start, Reader::Kind::object);
+            cpp_val.clear();
+            using Key = typename Map::key_type;
+            std::string_view key;
+            while (in.next_key(count, key)) {
+                auto it = cpp_val.try_emplace(Key(key, typename Key::allocator_type(cpp_val.get_allocator()))).first;
+                if (!Decoder<typename Map::mapped_type>::decode(in, it->second)) return fail_in(it->first);
+            }
+            return !in.failed() || fail(Errc::syntax);
+        }
+    };
+
+    // Written in the map's own order; CBOR does not ask for sorted keys.
+    template<typename Map>
+    struct MapEncoder {
+        template<typename Writer>
+        static void encode(Writer& out, const Map& cpp_val) {
+            out.object_begin(cpp_val.size());
+            for (const auto& [key, val] : cpp_val) {
+                out.key(key);
+                Encoder<typename Map::mapped_type>::encode(out, val);
+            }
+        }
+    };
+
+    template<typename KeyAlloc, typename T_val, typename Compare, typename Alloc>
+    struct Decoder<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>, void>
+        : MapDecoder<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>> {};
+
+    template<typename KeyAlloc, typename T_val, typename Compare, typename Alloc>
+    struct Encoder<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>, void>
+        : MapEncoder<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>> {};
+
+    template<typename KeyAlloc, typename T_val, typename Hash, typename Equal, typename Alloc>
+    struct Decoder<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>, void>
+        : MapDecoder<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>> {};
+
+    template<typename KeyAlloc, typename T_val, typename Hash, typename Equal, typename Alloc>
+    struct Encoder<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>, void>
+        : MapEncoder<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>> {};
+
+    template<typename T_val>
+    struct Decoder<std::optional<T_val>, void> {
+        // As with the other backends, null, {} and [] all mean "no value".
+        static bool decode(Reader& in, std::optional<T_val>& cpp_val) {
+            if (in.peek() == Reader::Kind::null || in.empty_container()) {
+                cpp_val.reset();
+                return in.skip() || fail(Errc::syntax);
+            }
+            if (!cpp_val) cpp_val.emplace();
+            if (Decoder<T_val>::decode(in, *cpp_val)) {
+                return true;
+            }
+            cpp_val.reset();
+            return false;
+        }
+    };
+
+    template<typename T_val>
+    struct Encoder<std::optional<T_val>, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const std::optional<T_val>& cpp_val) {
+            if (cpp_val) Encoder<T_val>::encode(out, *cpp_val);
+            else out.null();
+        }
+    };
+
+    template<typename T_val>
+    struct Decoder<std::unique_ptr<T_val>, void> {
+        static bool decode(Reader& in, std::unique_ptr<T_val>& cpp_val) {
+            if (in.peek() == Reader::Kind::null) {
+                cpp_val.reset();
+                return in.null() || fail(Errc::syntax);
+            }
+            if (!cpp_val) cpp_val = std::make_unique<T_val>();
+            if (Decoder<T_val>::decode(in, *cpp_val)) return true;
+            cpp_val.reset();
+            return false;
+        }
+    };
+
+    template<typename T_val>
+    struct Encoder<std::unique_ptr<T_val>, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const std::unique_ptr<T_val>& cpp_val) {
+            if (cpp_val) Encoder<T_val>::encode(out, *cpp_val);
+            else out.null();
+        }
+    };
+
+    template<typename T_val>
+    struct Decoder<std::shared_ptr<T_val>, void> {
+        static bool decode(Reader& in, std::shared_ptr<T_val>& cpp_val) {
+            if (in.peek() == Reader::Kind::null) {
+                cpp_val.reset();
+                return in.null() || fail(Errc::syntax);
+            }
+            auto fresh = std::make_shared<T_val>();
+            if (!Decoder<T_val>::decode(in, *fresh)) {
+                cpp_val.reset();
+                return false;
+            }
+            cpp_val = std::move(fresh);
+            return true;
+        }
+    };
+
+    template<typename T_val>
+    struct Encoder<std::shared_ptr<T_val>, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const std::shared_ptr<T_val>& cpp_val) {
+            if (cpp_val) Encoder<T_val>::encode(out, *cpp_val);
+            else out.null();
+        }
+    };
+
+    template<typename... Types>
+    struct Decoder<std::variant<Types...>, void> {
+        using Variant = std::variant<Types...>;
+
+        // As with the other backends: a tagged variant goes straight to the
+        // alternative its tag names, otherwise the first alternative which
+        // decodes wins.  CBOR tells integers from reals, so the kind check
+        // is as exact as a DOM's.
+        static bool decode(Reader& in, Variant& cpp_val) {
+            const std::size_t start = in.position();
+            if constexpr (is_tagged_variant<Types...>) {
+                std::string_view name;
+                const Reader::Kind tag = in.find_member(variant_tag_key<Types...>, name);
+                if (tag != Reader::Kind::string) {
+                    in.seek(start);
+                    if (in.peek() != Reader::Kind::object) return fail(Errc::type_mismatch);
+                    fail(tag == Reader::Kind::end ? Errc::missing_required : Errc::type_mismatch);
+                    return fail_in(variant_tag_key<Types...>);
+                }
+                bool success = false;
+                if (!((name == Types::json_tag ? (success = try_alternative<Types>(in, start, cpp_val), true) : false) || ...)) {
+                    fail(Errc::variant_no_match);
+                    return fail_in(variant_tag_key<Types...>);
+                }
+                return success;
+            } else {
+                const unsigned kind = kind_bits(in.peek());
+                return ((json_kinds<Types>::value & kind && try_alternative<Types>(in, start, cpp_val)) || ...)
+                    || fail(Errc::variant_no_match);
+            }
+        }
+    private:
+        static unsigned kind_bits(Reader::Kind k) {
+            switch (k) {
+            case Reader::Kind::null: return kind_null;
+            case Reader::Kind::boolean: return kind_boolean;
+            case Reader::Kind::integer: return kind_integer;
+            case Reader::Kind::real: return kind_real;
+            case Reader::Kind::string: return kind_string;
+            case Reader::Kind::array: return kind_array;
+            case Reader::Kind::object: return kind_object;
+            default: return 0;
+            }
+        }
+
+        template<typename Alt>
+        static bool try_alternative(Reader& in, std::size_t start, Variant& cpp_val) {
+            if (Alt* held = std::get_if<Alt>(&cpp_val)) {
+                if (Decoder<Alt>::decode(in, *held)) return true;
+            } else {
+                Alt temp_value{};
+                if (Decoder<Alt>::decode(in, temp_value)) {
+                    cpp_val.template emplace<Alt>(std::move(temp_value));
+                    return true;
+                }
+            }
+            in.seek(start);
+            return false;
+        }
+    };
+
+    template<typename... Types>
+    struct Encoder<std::variant<Types...>, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const std::variant<Types...>& cpp_val) {
+            std::visit([&](const auto& arg) {
+                using Alt = std::decay_t<decltype(arg)>;
+                if constexpr (is_tagged_variant<Types...>) {
+                    Encoder<Alt>::encode(out, arg, variant_tag_key<Types...>, Alt::json_tag);
+                } else {
+                    Encoder<Alt>::encode(out, arg);
+                }
+            }, cpp_val);
+        }
+    };
+
+    template<typename T>
+    struct Decoder<T, std::enable_if_t<has_config_fields<T>::value>> {
+        static bool decode(Reader& in, T& out_obj) {
+            const std::size_t start = in.position();
+            std::size_t count;
+            if (!in.object_begin(count)) return fail_read(in, start, Reader::Kind::object);
+            return decode_members(in, count, out_obj, std::make_index_sequence<field_count<T>>{});
+        }
+
+    private:
+        template<std::size_t I>
+        static bool decode_member(Reader& in, T& out_obj) {
+            const auto& field = std::get<I>(field_table<T>());
+            using MemberType = std::decay_t<decltype(out_obj.*field.ptr_to_member)>;
+            return Decoder<MemberType>::decode(in, out_obj.*field.ptr_to_member) || fail_in(field.name);
+        }
+
+        // Each key in the input is sent to its field through FieldIndex.
+        template<std::size_t... Is>
+        static bool decode_members(Reader& in, std::size_t count, T& out_obj, std::index_sequence<Is...>) {
+            using MemberDecoder = bool (*)(Reader&, T&);
+            static constexpr MemberDecoder decoders[] = {&decode_member<Is>..., nullptr};
+            const auto& index = FieldIndex<T>::get();
+
+            std::array<bool, sizeof...(Is)> seen{};
+            std::string_view key;
+            while (in.next_key(count, key)) {
+                const std::size_t i = index.find(key);
+                if (i == FieldIndex<T>::npos) {
+                    if (!in.skip()) {
+                        fail(Errc::syntax);
+                        return fail_in(key);
+                    }
+                } else {
+                    seen[i] = true;
+                    if (!decoders[i](in, out_obj)) return false;
+                }
+            }
+            if (in.failed()) return fail(Errc::syntax);
+            // Absent members get Field's default/required treatment.
+            FirstError success;
+            ((success &= seen[Is] || std::get<Is>(field_table<T>()).use_default(out_obj)), ...);
+            return success.result();
+        }
+    };
+
+    template<typename T>
+    struct Encoder<T, std::enable_if_t<has_config_fields<T>::value>> {
+        template<typename Writer>
+        static void encode(Writer& out, const T& obj) { encode(out, obj, nullptr, {}); }
+
+        // With one more text member first, extra_key (unless null), as a
+        // tagged variant's discriminator.  Fields go in config_fields()
+        // order.
+        template<typename Writer>
+        static void encode(Writer& out, const T& obj, const char* extra_key, std::string_view extra_value) {
+            out.object_begin(field_count<T> + (extra_key ? 1 : 0));
+            if (extra_key) {
+                out.key(extra_key);
+                out.string(extra_value);
+            }
+            std::apply([&](const auto&... field) {
+                ((out.key(field.name),
+                  Encoder<std::decay_t<decltype(obj.*field.ptr_to_member)>>::encode(out, obj.*field.ptr_to_member)), ...);
+            }, field_table<T>());
+        }
+    };
+
+    /// Append obj as one CBOR item to a Sink.
+    template<typename T, typename Sink>
+    void write_cbor(const T& obj, Sink& sink) {
+        Writer<Sink> out(sink);
+        Encoder<T>::encode(out, obj);
+    }
+
+    /// Serialize obj to CBOR.
+    template<typename T>
+    std::vector<std::uint8_t> to_cbor(const T& obj) {
+        std::vector<std::uint8_t> bytes;
+        write_cbor(obj, bytes);
+        return bytes;
+    }
+
+    /// Decode one complete CBOR item into obj.  Returns false if the input
+    /// is not well-formed, has trailing bytes, or does not match T, with the
+    /// reason in last_error().
+    template<typename T>
+    bool from_cbor(const std::uint8_t* data, std::size_t size, T& obj) {
+        Reader in(data, size);
+        return Decoder<T>::decode(in, obj) && (in.at_end() || fail(Errc::syntax));
+    }
+
+    template<typename T>
+    bool from_cbor(const std::vector<std::uint8_t>& bytes, T& obj) {
+        return from_cbor(bytes.data(), bytes.size(), obj);
+    }
+}
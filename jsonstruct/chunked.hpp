@@ -0,0 +1,718 @@
+#pragma once
+
+#include <jsonstruct/stream.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jsonstruct::stream {
+
+    // Decoding JSON text which arrives in pieces, as from a socket, without
+    // first collecting all of it.
+    //
+    // A ChunkedDecoder is fed the pieces as they come.  A tokenizer with
+    // its state kept between feeds finds the tokens, and a stack of frames,
+    // one per object or array being decoded, sends each to its place in
+    // the C++ value: structs, sequences, maps, std::array, and optionals
+    // and pointers of these are decoded member by member as their text
+    // arrives.  Every other type (numbers, strings, enums, variants, ...)
+    // is decoded whole by its Decoder once its text is complete, so only
+    // the text of one such value is ever held, and only while it spans
+    // pieces.  An untagged variant can not tell which alternative a value
+    // is before the end of it, so a variant of objects or arrays is held
+    // whole; a tagged variant is held as well, its tag being anywhere in
+    // the object.
+
+    class ChunkedDecoder;
+
+    struct Sink;
+
+    // Where the next value goes: a target and the Sink of its type, or no
+    // Sink for a value which is skipped (an unknown member).
+    struct Slot {
+        const Sink* sink;
+        void* target;
+    };
+
+    // How values of one type are decoded.  A type decoded whole has
+    // decode(); a type decoded member by member has scalar() and open().
+    struct Sink {
+        // The complete text of the value.
+        bool (*decode)(void* target, std::string_view text);
+        // A scalar token, or the start of an object or array, which
+        // pushes a frame.
+        bool (*scalar)(ChunkedDecoder& in, void* target, Reader::Kind kind, std::string_view token);
+        bool (*open)(ChunkedDecoder& in, void* target, bool object);
+    };
+
+    struct ChunkFrame;
+
+    // The operations of one kind of frame.
+    struct FrameOps {
+        // A member's key, for an object: set next to where its value goes.
+        bool (*key)(ChunkedDecoder& in, ChunkFrame& frame, std::string_view key, Slot& next);
+        // The start of an element, for an array.
+        bool (*element)(ChunkedDecoder& in, ChunkFrame& frame, Slot& next);
+        // The closing brace or bracket.
+        bool (*close)(ChunkedDecoder& in, ChunkFrame& frame);
+        // fail_in() the member or element being decoded.
+        void (*segment)(const ChunkFrame& frame);
+    };
+
+    // One object or array being decoded.  Frames are reused from one
+    // document to the next, keeping the capacity of key.
+    struct ChunkFrame {
+        const FrameOps* ops;
+        void* target;
+        std::size_t count;          // members or elements begun
+        bool member_open;           // within a member or element
+        const char* field;          // a struct's field being decoded
+        std::string key;            // a map's key, or an unknown member's
+        std::size_t flags;          // where its flags begin in the decoder
+        // Called instead of close() if the container was empty: an
+        // optional holding it takes {} and [] to mean "no value".
+        void* owner;
+        void (*on_empty)(void* owner);
+    };
+
+    /// Decodes one JSON document into a C++ value from pieces of its text
+    /// of any size, fed as they arrive.
+    ///
+    ///     ServerConfig config;
+    ///     stream::ChunkedDecoder decoder(config);
+    ///     while (auto piece = socket.read()) {
+    ///         if (!decoder.feed(piece)) return reject(last_error());
+    ///     }
+    ///     bool ok = decoder.finish();
+    ///
+    /// Decoding keeps pace with the input, and what is held besides the
+    /// value itself is bounded by the nesting depth and by the largest
+    /// value decoded whole (see above), not by the size of the document.
+    /// Accepts what from_json() does, with the same defaults, and rejects
+    /// what it rejects.  Syntax is checked as the text arrives, so the
+    /// error's code or path may not be the one from_json() reports.
+    /// The value must outlive the decoder; std::string_view members, which
+    /// would borrow from text no longer held, are not supported.
+    class ChunkedDecoder {
+    public:
+        template<typename T>
+        explicit ChunkedDecoder(T& obj) { reset(obj); }
+
+        /// Start over on a new document, into obj.  Buffers are kept.
+        template<typename T>
+        void reset(T& obj);
+
+        /// Decode the next piece of text.  False once the text is found to
+        /// be invalid or not to match, with the reason in last_error();
+        /// the value is then partly decoded.
+        bool feed(std::string_view text);
+        bool feed(const char* data, std::size_t size) { return feed(std::string_view(data, size)); }
+
+        /// The end of the text: true if it held one complete document,
+        /// which obj now holds.
+        bool finish();
+
+        /// True once the document is complete; anything but whitespace
+        /// fed after it fails.
+        bool done() const { return !failed_ && expect_ == Expect::done && lex_ == Lex::between; }
+
+        // For the Sinks and frames: begin decoding an object or array into
+        // target, with flags zeroed flags for its own use.
+        ChunkFrame& push(const FrameOps* ops, void* target, std::size_t flags = 0);
+        unsigned char* flags(const ChunkFrame& frame) { return flags_.data() + frame.flags; }
+        ChunkFrame& top() { return frames_[depth_ - 1]; }
+
+    private:
+        static constexpr int max_depth = 512;
+
+        enum class Lex { between, string, number, literal };
+        enum class Expect { value, value_or_close, key, key_or_close, colon, comma_or_close, done };
+        enum class Passive { none, skip, capture };
+
+        // Text from a mark in one piece to a point in this or a later one:
+        // a view into the piece if it is all there, else copied into held.
+        struct Span {
+            static constexpr std::size_t npos = std::string_view::npos;
+            std::size_t mark = npos;
+            std::string held;
+
+            void begin(std::size_t at) { mark = at; held.clear(); }
+            // The piece ends with the span still open.
+            void carry(std::string_view piece) {
+                if (mark == npos) return;
+                held.append(piece.data() + mark, piece.size() - mark);
+                mark = 0;
+            }
+            std::string_view end(std::string_view piece, std::size_t at) {
+                const std::size_t from = mark;
+                mark = npos;
+                if (held.empty()) return piece.substr(from, at - from);
+                held.append(piece.data() + from, at - from);
+                return held;
+            }
+        };
+
+        bool fail_syntax() { return fail_below(depth_, Errc::syntax); }
+
+        // Record code, if any, then the path down to the innermost
+        // depth frames, and stop.
+        bool fail_below(std::size_t depth, Errc code = Errc::none) {
+            if (code != Errc::none) fail(code);
+            for (std::size_t d = depth; d-- > 0;) frames_[d].ops->segment(frames_[d]);
+            failed_ = true;
+            return false;
+        }
+
+        bool expecting_value() const { return expect_ == Expect::value || expect_ == Expect::value_or_close; }
+
+        // The slot of the value which begins now.
+        bool next_slot(Slot& slot) {
+            if (depth_ == 0) {
+                slot = root_;
+                return true;
+            }
+            ChunkFrame& frame = top();
+            if (nesting_.back() == '{') {
+                slot = pending_;
+                return true;
+            }
+            ++frame.count;
+            frame.member_open = true;
+            return frame.ops->element(*this, frame, slot) || fail_below(depth_ - 1);
+        }
+
+        // A value (or a nested container closing in a skipped or held
+        // value) is complete.
+        void value_done() {
+            expect_ = nesting_.empty() ? Expect::done : Expect::comma_or_close;
+            if (passive_ == Passive::none && depth_) top().member_open = false;
+        }
+
+        // Whether a number or literal token is well formed; a literal's
+        // kind is then known.
+        bool well_formed(std::string_view token) {
+            if (token_kind_ == Reader::Kind::number) {
+                Reader check(token);
+                std::string_view t;
+                bool is_integer;
+                return check.number(t, is_integer) && check.position() == token.size();
+            }
+            if (token_kind_ == Reader::Kind::string) return true;
+            token_kind_ = token == "null" ? Reader::Kind::null : Reader::Kind::boolean;
+            return token == "true" || token == "false" || token == "null";
+        }
+
+        bool token_done(std::string_view token) {
+            if (token_is_key_) {
+                expect_ = Expect::colon;
+                if (passive_ == Passive::capture) return true;
+                // Unescaped even when skipped, as Reader::skip() does.
+                Reader unescape(token);
+                std::string_view key;
+                if (!unescape.scratch_string(key)) return fail_syntax();
+                if (passive_ == Passive::skip) return true;
+                ChunkFrame& frame = top();
+                ++frame.count;
+                frame.member_open = true;
+                return frame.ops->key(*this, frame, key, pending_) || fail_below(depth_ - 1);
+            }
+            Slot slot{nullptr, nullptr};
+            if (passive_ == Passive::none && !next_slot(slot)) return false;
+            if (slot.sink && slot.sink->decode) {
+                // The Decoder judges a malformed token as from_json() does,
+                // and so does the one a captured value is handed to.
+                if (!slot.sink->decode(slot.target, token)) return fail_below(depth_);
+            } else if (passive_ != Passive::capture && !well_formed(token)) {
+                return fail_syntax();
+            } else if (slot.sink && !slot.sink->scalar(*this, slot.target, token_kind_, token)) {
+                return fail_below(depth_);
+            }
+            value_done();
+            return true;
+        }
+
+        bool open(std::size_t at, bool object) {
+            if (!expecting_value()) return fail_syntax();
+            Slot slot{nullptr, nullptr};
+            if (passive_ == Passive::none && !next_slot(slot)) return false;
+            nesting_.push_back(object ? '{' : '[');
+            expect_ = object ? Expect::key_or_close : Expect::value_or_close;
+            if (passive_ != Passive::none) {
+                ++passive_depth_;
+                return passive_ == Passive::capture || passive_depth_ <= max_depth || fail_syntax();
+            }
+            if (!slot.sink || slot.sink->decode) {
+                passive_ = slot.sink ? Passive::capture : Passive::skip;
+                passive_depth_ = 1;
+                held_slot_ = slot;
+                if (slot.sink) value_.begin(at);   // a skipped value is not kept
+                return true;
+            }
+            return slot.sink->open(*this, slot.target, object) || fail_below(depth_);
+        }
+
+        bool close(std::size_t at, char closer) {
+            const bool allowed = expect_ == Expect::comma_or_close
+                || expect_ == (closer == '}' ? Expect::key_or_close : Expect::value_or_close);
+            if (!allowed || nesting_.back() != (closer == '}' ? '{' : '[')) return fail_syntax();
+            nesting_.pop_back();
+            if (passive_ != Passive::none) {
+                if (--passive_depth_ == 0) {
+                    const bool held = passive_ == Passive::capture;
+                    passive_ = Passive::none;
+                    if (held && !held_slot_.sink->decode(held_slot_.target, value_.end(piece_, at + 1))) {
+                        return fail_below(depth_);
+                    }
+                }
+                value_done();
+                return true;
+            }
+            ChunkFrame& frame = top();
+            bool ok = true;
+            if (frame.count == 0 && frame.on_empty) frame.on_empty(frame.owner);
+            else ok = frame.ops->close(*this, frame);
+            flags_.resize(frame.flags);
+            --depth_;
+            if (!ok) return fail_below(depth_);
+            value_done();
+            return true;
+        }
+
+        // One character between tokens; returns where to go on.
+        std::size_t between(std::size_t i) {
+            const char c = piece_[i];
+            switch (c) {
+            case ' ': case '\n': case '\r': case '\t':
+                return i + 1;
+            case '{': case '[':
+                open(i, c == '{');
+                return i + 1;
+            case '}': case ']':
+                close(i, c);
+                return i + 1;
+            case ',':
+                if (expect_ != Expect::comma_or_close) fail_syntax();
+                else expect_ = nesting_.back() == '{' ? Expect::key : Expect::value;
+                return i + 1;
+            case ':':
+                if (expect_ != Expect::colon) fail_syntax();
+                else expect_ = Expect::value;
+                return i + 1;
+            case '"':
+                token_is_key_ = expect_ == Expect::key || expect_ == Expect::key_or_close;
+                if (!token_is_key_ && !expecting_value()) {
+                    fail_syntax();
+                    return i + 1;
+                }
+                begin_token(i, Lex::string, Reader::Kind::string);
+                escape_ = false;
+                return i + 1;
+            case '-': case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9':
+                if (!expecting_value()) fail_syntax();
+                else begin_token(i, Lex::number, Reader::Kind::number);
+                return i;
+            case 't': case 'f': case 'n':
+                if (!expecting_value()) fail_syntax();
+                else begin_token(i, Lex::literal, Reader::Kind::boolean);
+                return i;
+            default:
+                fail_syntax();
+                return i + 1;
+            }
+        }
+
+        void begin_token(std::size_t at, Lex lex, Reader::Kind kind) {
+            token_is_key_ = lex == Lex::string && token_is_key_;
+            lex_ = lex;
+            token_kind_ = kind;
+            token_.begin(at);
+        }
+
+        // Within a string token: on to the closing quote, if it is here.
+        std::size_t in_string(std::size_t i) {
+            const std::size_t size = piece_.size();
+            if (escape_ && i < size) {
+                escape_ = false;
+                ++i;
+            }
+            while (i < size) {
+                const char c = piece_[i];
+                if (c == '"') {
+                    lex_ = Lex::between;
+                    token_done(token_.end(piece_, i + 1));
+                    return i + 1;
+                }
+                if (c == '\\') {
+                    if (i + 1 == size) {
+                        escape_ = true;
+                        return size;
+                    }
+                    i += 2;
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    fail_syntax();
+                    return i;
+                } else {
+                    ++i;
+                }
+            }
+            return size;
+        }
+
+        // Within a number or literal: on to its end, if it is here.
+        std::size_t in_word(std::size_t i) {
+            const std::size_t size = piece_.size();
+            for (; i < size; ++i) {
+                const char c = piece_[i];
+                const bool part = lex_ == Lex::number
+                    ? (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'
+                    : c >= 'a' && c <= 'z';
+                if (!part) {
+                    lex_ = Lex::between;
+                    token_done(token_.end(piece_, i));
+                    return i;
+                }
+            }
+            return i;
+        }
+
+        std::vector<ChunkFrame> frames_;
+        std::size_t depth_{0};              // frames in use
+        std::vector<unsigned char> flags_;  // the frames' flags, stacked
+        std::vector<char> nesting_;         // '{' or '[' for every open container
+        Slot root_{nullptr, nullptr};
+        Slot pending_{nullptr, nullptr};    // where the current member's value goes
+        Slot held_slot_{nullptr, nullptr};  // where the value being held goes
+        Passive passive_{Passive::none};
+        int passive_depth_{0};
+        Lex lex_{Lex::between};
+        Expect expect_{Expect::value};
+        Reader::Kind token_kind_{Reader::Kind::null};
+        bool token_is_key_{false};
+        bool escape_{false};
+        bool failed_{false};
+        std::string_view piece_;
+        Span token_;    // the token being read
+        Span value_;    // the value being held
+    };
+
+    inline ChunkFrame& ChunkedDecoder::push(const FrameOps* ops, void* target, std::size_t flags) {
+        if (depth_ == frames_.size()) frames_.emplace_back();
+        ChunkFrame& frame = frames_[depth_++];
+        frame.ops = ops;
+        frame.target = target;
+        frame.count = 0;
+        frame.member_open = false;
+        frame.field = nullptr;
+        frame.flags = flags_.size();
+        frame.owner = nullptr;
+        frame.on_empty = nullptr;
+        flags_.resize(flags_.size() + flags, 0);
+        return frame;
+    }
+
+    inline bool ChunkedDecoder::feed(std::string_view text) {
+        if (failed_) return false;
+        piece_ = text;
+        std::size_t i = 0;
+        while (i < text.size() && !failed_) {
+            switch (lex_) {
+            case Lex::between:
+                i = between(i);
+                break;
+            case Lex::string:
+                i = in_string(i);
+                break;
+            case Lex::number:
+            case Lex::literal:
+                i = in_word(i);
+                break;
+            }
+        }
+        if (failed_) return false;
+        token_.carry(text);
+        value_.carry(text);
+        return true;
+    }
+
+    inline bool ChunkedDecoder::finish() {
+        if (failed_) return false;
+        if (lex_ == Lex::number || lex_ == Lex::literal) {
+            lex_ = Lex::between;
+            if (!token_done(token_.end(std::string_view(), 0))) return false;
+        }
+        return (lex_ == Lex::between && expect_ == Expect::done) || fail_syntax();
+    }
+
+    // --- How each type is decoded ---
+
+    template<typename T, typename Enable = void>
+    struct Chunked;
+
+    template<typename T>
+    const Sink* sink_of() {
+        static constexpr Sink sink{Chunked<T>::decode, Chunked<T>::scalar, Chunked<T>::open};
+        return &sink;
+    }
+
+    // The FrameOps of Ops' static functions.
+    template<typename Ops>
+    const FrameOps* frame_ops() {
+        static constexpr FrameOps ops{Ops::key, Ops::element, Ops::close, Ops::segment};
+        return &ops;
+    }
+
+    // Whether T is decoded member by member.
+    template<typename T>
+    inline constexpr bool is_streamed = std::is_null_pointer_v<decltype(Chunked<T>::decode)>;
+
+    // Everything else: decoded whole, by Decoder<T>, once its text is in.
+    template<typename T, typename Enable>
+    struct Chunked {
+        static_assert(!std::is_same_v<T, std::string_view>,
+                      "a std::string_view would borrow from text which the ChunkedDecoder does not keep");
+        static bool decode(void* target, std::string_view text) { return from_json(text, *static_cast<T*>(target)); }
+        static constexpr auto scalar = nullptr;
+        static constexpr auto open = nullptr;
+    };
+
+    // A scalar where an object or array must be.
+    inline bool container_scalar(ChunkedDecoder&, void*, Reader::Kind, std::string_view) {
+        return fail(Errc::type_mismatch);
+    }
+
+    // Fails element() and key() of frames which take the other.
+    inline bool no_element(ChunkedDecoder&, ChunkFrame&, Slot&) { return fail(Errc::syntax); }
+    inline bool no_key(ChunkedDecoder&, ChunkFrame&, std::string_view, Slot&) { return fail(Errc::syntax); }
+
+    template<typename Container>
+    struct ChunkedSequence {
+        using T_elem = typename Container::value_type;
+        static constexpr auto decode = nullptr;
+        static constexpr auto scalar = container_scalar;
+        static bool open(ChunkedDecoder& in, void* target, bool object) {
+            if (object) return fail(Errc::type_mismatch);
+            static_cast<Container*>(target)->clear();
+            in.push(frame_ops<ChunkedSequence>(), target);
+            return true;
+        }
+        static constexpr auto key = no_key;
+        static bool element(ChunkedDecoder&, ChunkFrame& frame, Slot& next) {
+            auto& c = *static_cast<Container*>(frame.target);
+            c.emplace_back();
+            next = Slot{sink_of<T_elem>(), &c.back()};
+            return true;
+        }
+        static bool close(ChunkedDecoder&, ChunkFrame&) { return true; }
+        static void segment(const ChunkFrame& frame) {
+            if (frame.member_open) fail_in(frame.count - 1);
+        }
+    };
+
+    // std::vector<bool> has no bool& to decode into, so is decoded whole.
+    template<typename T_elem, typename Alloc>
+    struct Chunked<std::vector<T_elem, Alloc>, std::enable_if_t<!std::is_same_v<T_elem, bool>>>
+        : ChunkedSequence<std::vector<T_elem, Alloc>> {};
+
+    template<typename T_elem, typename Alloc>
+    struct Chunked<std::deque<T_elem, Alloc>, void> : ChunkedSequence<std::deque<T_elem, Alloc>> {};
+
+    template<typename T_elem, std::size_t N>
+    struct Chunked<std::array<T_elem, N>, void> {
+        static constexpr auto decode = nullptr;
+        static constexpr auto scalar = container_scalar;
+        static bool open(ChunkedDecoder& in, void* target, bool object) {
+            if (object) return fail(Errc::type_mismatch);
+            in.push(frame_ops<Chunked>(), target);
+            return true;
+        }
+        static constexpr auto key = no_key;
+        static bool element(ChunkedDecoder&, ChunkFrame& frame, Slot& next) {
+            if (frame.count > N) return fail(Errc::type_mismatch);
+            next = Slot{sink_of<T_elem>(), &(*static_cast<std::array<T_elem, N>*>(frame.target))[frame.count - 1]};
+            return true;
+        }
+        static bool close(ChunkedDecoder&, ChunkFrame& frame) { return frame.count == N || fail(Errc::type_mismatch); }
+        static void segment(const ChunkFrame& frame) {
+            if (frame.member_open) fail_in(frame.count - 1);
+        }
+    };
+
+    template<typename Map>
+    struct ChunkedMap {
+        static constexpr auto decode = nullptr;
+        static constexpr auto scalar = container_scalar;
+        static bool open(ChunkedDecoder& in, void* target, bool object) {
+            if (!object) return fail(Errc::type_mismatch);
+            static_cast<Map*>(target)->clear();
+            in.push(frame_ops<ChunkedMap>(), target);
+            return true;
+        }
+        static bool key(ChunkedDecoder&, ChunkFrame& frame, std::string_view key, Slot& next) {
+            auto& m = *static_cast<Map*>(frame.target);
+            using Key = typename Map::key_type;
+            auto it = m.try_emplace(Key(key, typename Key::allocator_type(m.get_allocator()))).first;
+            frame.key.assign(key.data(), key.size());
+            next = Slot{sink_of<typename Map::mapped_type>(), &it->second};
+            return true;
+        }
+        static constexpr auto element = no_element;
+        static bool close(ChunkedDecoder&, ChunkFrame&) { return true; }
+        static void segment(const ChunkFrame& frame) {
+            if (frame.member_open) fail_in(frame.key);
+        }
+    };
+
+    template<typename KeyAlloc, typename T_val, typename Compare, typename Alloc>
+    struct Chunked<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>, void>
+        : ChunkedMap<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>> {};
+
+    template<typename KeyAlloc, typename T_val, typename Hash, typename Equal, typename Alloc>
+    struct Chunked<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>, void>
+        : ChunkedMap<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>> {};
+
+    // What an optional of a streamed type holds while the container it
+    // took turns out empty, when that is a kind the type can not take:
+    // anything in it fails.
+    struct ChunkedEmpty {
+        static bool key(ChunkedDecoder&, ChunkFrame&, std::string_view, Slot&) { return fail(Errc::type_mismatch); }
+        static bool element(ChunkedDecoder&, ChunkFrame&, Slot&) { return fail(Errc::type_mismatch); }
+        static bool close(ChunkedDecoder&, ChunkFrame&) { return true; }
+        static void segment(const ChunkFrame&) {}
+    };
+
+    // As with the other backends null, {} and [] all mean "no value".  The
+    // value is begun in place and dropped if its container ends empty.
+    template<typename T_val>
+    struct Chunked<std::optional<T_val>, std::enable_if_t<is_streamed<T_val>>> {
+        static constexpr auto decode = nullptr;
+        static bool scalar(ChunkedDecoder&, void* target, Reader::Kind kind, std::string_view) {
+            if (kind != Reader::Kind::null) return fail(Errc::type_mismatch);
+            static_cast<std::optional<T_val>*>(target)->reset();
+            return true;
+        }
+        static bool open(ChunkedDecoder& in, void* target, bool object) {
+            auto& opt = *static_cast<std::optional<T_val>*>(target);
+            if (json_kinds<T_val>::value & (object ? kind_object : kind_array)) {
+                if (!opt) opt.emplace();
+                if (!sink_of<T_val>()->open(in, &*opt, object)) return false;
+            } else {
+                in.push(frame_ops<ChunkedEmpty>(), nullptr);
+            }
+            ChunkFrame& frame = in.top();
+            frame.owner = target;
+            frame.on_empty = [](void* owner) { static_cast<std::optional<T_val>*>(owner)->reset(); };
+            return true;
+        }
+    };
+
+    template<typename T_val>
+    struct Chunked<std::unique_ptr<T_val>, std::enable_if_t<is_streamed<T_val>>> {
+        static constexpr auto decode = nullptr;
+        static bool scalar(ChunkedDecoder&, void* target, Reader::Kind kind, std::string_view) {
+            if (kind != Reader::Kind::null) return fail(Errc::type_mismatch);
+            static_cast<std::unique_ptr<T_val>*>(target)->reset();
+            return true;
+        }
+        static bool open(ChunkedDecoder& in, void* target, bool object) {
+            auto& ptr = *static_cast<std::unique_ptr<T_val>*>(target);
+            if (!ptr) ptr = std::make_unique<T_val>();   // else reuse the pointee
+            return sink_of<T_val>()->open(in, ptr.get(), object);
+        }
+    };
+
+    template<typename T_val>
+    struct Chunked<std::shared_ptr<T_val>, std::enable_if_t<is_streamed<T_val>>> {
+        static constexpr auto decode = nullptr;
+        static bool scalar(ChunkedDecoder&, void* target, Reader::Kind kind, std::string_view) {
+            if (kind != Reader::Kind::null) return fail(Errc::type_mismatch);
+            static_cast<std::shared_ptr<T_val>*>(target)->reset();
+            return true;
+        }
+        static bool open(ChunkedDecoder& in, void* target, bool object) {
+            // A fresh pointee: the old one may be shared with other owners.
+            auto& ptr = *static_cast<std::shared_ptr<T_val>*>(target);
+            ptr = std::make_shared<T_val>();
+            return sink_of<T_val>()->open(in, ptr.get(), object);
+        }
+    };
+
+    // Structs: each key sent to its field through FieldIndex, and the
+    // fields never seen given their defaults at the closing brace.  One
+    // flag per field records which were seen.
+    template<typename T>
+    struct Chunked<T, std::enable_if_t<has_config_fields<T>::value>> {
+        static constexpr auto decode = nullptr;
+        static constexpr auto scalar = container_scalar;
+        static bool open(ChunkedDecoder& in, void* target, bool object) {
+            if (!object) return fail(Errc::type_mismatch);
+            in.push(frame_ops<Chunked>(), target, field_count<T>);
+            return true;
+        }
+        static bool key(ChunkedDecoder& in, ChunkFrame& frame, std::string_view key, Slot& next) {
+            return key_of(in, frame, key, next, std::make_index_sequence<field_count<T>>{});
+        }
+        static constexpr auto element = no_element;
+        static bool close(ChunkedDecoder& in, ChunkFrame& frame) {
+            return defaults(in.flags(frame), *static_cast<T*>(frame.target), std::make_index_sequence<field_count<T>>{});
+        }
+        static void segment(const ChunkFrame& frame) {
+            if (!frame.member_open) return;
+            if (frame.field) fail_in(frame.field);
+            else fail_in(frame.key);
+        }
+
+    private:
+        template<std::size_t I>
+        static Slot slot_of(ChunkFrame& frame) {
+            const auto& field = std::get<I>(field_table<T>());
+            using MemberType = std::decay_t<decltype(std::declval<T&>().*field.ptr_to_member)>;
+            frame.field = field.name;
+            return Slot{sink_of<MemberType>(), &(static_cast<T*>(frame.target)->*field.ptr_to_member)};
+        }
+
+        template<std::size_t... Is>
+        static bool key_of(ChunkedDecoder& in, ChunkFrame& frame, std::string_view key, Slot& next, std::index_sequence<Is...>) {
+            using SlotOf = Slot (*)(ChunkFrame&);
+            static constexpr SlotOf slots[] = {&slot_of<Is>..., nullptr};
+            const std::size_t i = FieldIndex<T>::get().find(key);
+            if (i == FieldIndex<T>::npos) {
+                // Skipped; named by its key should it turn out malformed.
+                frame.field = nullptr;
+                frame.key.assign(key.data(), key.size());
+                next = Slot{nullptr, nullptr};
+                return true;
+            }
+            in.flags(frame)[i] = 1;
+            next = slots[i](frame);
+            return true;
+        }
+
+        template<std::size_t... Is>
+        static bool defaults(const unsigned char* seen, T& obj, std::index_sequence<Is...>) {
+            FirstError success;
+            ((success &= seen[Is] || std::get<Is>(field_table<T>()).use_default(obj)), ...);
+            return success.result();
+        }
+    };
+
+    template<typename T>
+    void ChunkedDecoder::reset(T& obj) {
+        root_ = Slot{sink_of<T>(), &obj};
+        pending_ = held_slot_ = Slot{nullptr, nullptr};
+        depth_ = 0;
+        flags_.clear();
+        nesting_.clear();
+        passive_ = Passive::none;
+        passive_depth_ = 0;
+        lex_ = Lex::between;
+        expect_ = Expect::value;
+        failed_ = false;
+        token_.mark = value_.mark = Span::npos;
+    }
+}
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <jsonstruct/converter.hpp>
+#include <jsonstruct/stream.hpp>
+#include <jsonstruct/stream_writer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace jsonstruct {
+
+    // The member type of a Field.
+    template<typename F>
+    struct field_member;
+
+    template<typename StructType, typename MemberType>
+    struct field_member<Field<StructType, MemberType>> { using type = MemberType; };
+
+    // One std::vector per field of T, in config_fields() order.
+    template<typename T, typename Fields = std::decay_t<decltype(T::config_fields())>>
+    struct column_storage;
+
+    template<typename T, typename... Fs>
+    struct column_storage<T, std::tuple<Fs...>> {
+        using type = std::tuple<std::vector<typename field_member<Fs>::type>...>;
+    };
+
+    /// Records of T stored as columns (struct of arrays): one contiguous
+    /// std::vector per field of T, all of size().
+    ///
+    /// Converts to and from a JSON array of T objects like
+    /// std::vector<T>, with the same default and required field rules, on
+    /// every backend.  Each record's members are decoded straight into
+    /// their columns, with no T built on the way.  Scanning a column
+    /// touches only that field's values, contiguously.
+    template<typename T>
+    class Columns {
+    public:
+        using record_type = T;
+        using storage_type = typename column_storage<T>::type;
+        static constexpr std::size_t width = field_count<T>;
+
+        std::size_t size() const { return std::get<0>(columns_).size(); }
+        bool empty() const { return size() == 0; }
+
+        /// The column of T's I-th field.
+        template<std::size_t I>
+        auto& column() { return std::get<I>(columns_); }
+        template<std::size_t I>
+        const auto& column() const { return std::get<I>(columns_); }
+
+        void reserve(std::size_t n) { each([&](auto& col) { col.reserve(n); }); }
+        void clear() { each([](auto& col) { col.clear(); }); }
+        /// New rows are value-initialized, not given T's defaults.
+        void resize(std::size_t n) { each([&](auto& col) { col.resize(n); }); }
+
+        void push_back(const T& record) { push_back(record, std::make_index_sequence<width>{}); }
+
+        /// Row i as a record.
+        T row(std::size_t i) const { return row(i, std::make_index_sequence<width>{}); }
+
+    private:
+        template<typename Func>
+        void each(Func&& func) { std::apply([&](auto&... col) { (func(col), ...); }, columns_); }
+
+        template<std::size_t... Is>
+        void push_back(const T& record, std::index_sequence<Is...>) {
+            (std::get<Is>(columns_).push_back(record.*std::get<Is>(field_table<T>()).ptr_to_member), ...);
+        }
+
+        template<std::size_t... Is>
+        T row(std::size_t i, std::index_sequence<Is...>) const {
+            T record{};
+            ((record.*std::get<Is>(field_table<T>()).ptr_to_member = std::get<Is>(columns_)[i]), ...);
+            return record;
+        }
+
+        static_assert(width > 0, "Columns needs a struct with at least one field");
+        storage_type columns_;
+    };
+
+    template<typename T>
+    struct json_kinds<Columns<T>> : std::integral_constant<unsigned, kind_array> {};
+
+    // Element i of a column through a plain reference, which
+    // std::vector<bool> can not give.
+    template<typename Column, typename Func>
+    bool with_element(Column& col, std::size_t i, Func&& func) {
+        if constexpr (std::is_same_v<typename Column::value_type, bool>) {
+            bool val = col[i];
+            const bool ok = func(val);
+            col[i] = val;
+            return ok;
+        } else {
+            return func(col[i]);
+        }
+    }
+
+    template<typename T, typename JsonLibTraits>
+    struct Converter<Columns<T>, JsonLibTraits, void> {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+
+        static bool fromJson(const JsonValueType& j_val, Columns<T>& cpp_val) {
+            if (!JsonLibTraits::is_array(j_val)) return fail(Errc::type_mismatch);
+            cpp_val.resize(JsonLibTraits::array_size(j_val));
+            std::size_t row = 0;
+            for (const auto& elem : j_val) {
+                if (!JsonLibTraits::is_object(elem)) {
+                    fail(Errc::type_mismatch);
+                    return fail_in(row);
+                }
+                if (!from_record(elem, cpp_val, row, std::make_index_sequence<field_count<T>>{})) return fail_in(row);
+                ++row;
+            }
+            return true;
+        }
+
+        static JsonValueType toJson(const Columns<T>& cpp_val) {
+            JsonValueType j_arr = JsonLibTraits::create_array();
+            JsonLibTraits::reserve_array(j_arr, cpp_val.size());
+            for (std::size_t i = 0; i < cpp_val.size(); ++i) {
+                JsonLibTraits::append_array_element(j_arr, JsonLibTraits::create_object());
+            }
+            to_columns(j_arr, cpp_val, std::make_index_sequence<field_count<T>>{});
+            return j_arr;
+        }
+
+    private:
+        // One record's members, each into its own column.
+        template<std::size_t... Is>
+        static bool from_record(const JsonValueType& j_obj, Columns<T>& cpp_val, std::size_t row, std::index_sequence<Is...>) {
+            return (from_member<Is>(j_obj, cpp_val.template column<Is>(), row) && ...);
+        }
+
+        template<std::size_t I, typename Column>
+        static bool from_member(const JsonValueType& j_obj, Column& col, std::size_t row) {
+            using MemberType = typename Column::value_type;
+            const auto& field = std::get<I>(field_table<T>());
+            const JsonValueType* member_json = JsonLibTraits::find_member(j_obj, field.name);
+            return with_element(col, row, [&](MemberType& val) {
+                return member_json ? Converter<MemberType, JsonLibTraits>::fromJson(*member_json, val) || fail_in(field.name)
+                                   : field.default_into(val);
+            });
+        }
+
+        // One pass over the records per field.
+        template<std::size_t... Is>
+        static void to_columns(JsonValueType& j_arr, const Columns<T>& cpp_val, std::index_sequence<Is...>) {
+            (to_column<Is>(j_arr, cpp_val.template column<Is>()), ...);
+        }
+
+        template<std::size_t I, typename Column>
+        static void to_column(JsonValueType& j_arr, const Column& col) {
+            using MemberType = typename Column::value_type;
+            const char* name = std::get<I>(field_table<T>()).name;
+            std::size_t i = 0;
+            for (auto& elem : j_arr) {
+                JsonLibTraits::set_member(elem, name, Converter<MemberType, JsonLibTraits>::toJson(col[i++]));
+            }
+        }
+    };
+}
+
+namespace jsonstruct::stream {
+
+    // Text is read a record at a time, each member straight into its
+    // column.
+    template<typename T>
+    struct Decoder<Columns<T>, void> {
+        static bool decode(Reader& in, Columns<T>& cpp_val) {
+            std::size_t start = in.position();
+            if (!in.array_begin()) return fail_read(in, start, Reader::Kind::array);
+            cpp_val.clear();
+            while (in.next_element()) {
+                const std::size_t row = cpp_val.size();
+                cpp_val.resize(row + 1);
+                start = in.position();
+                if (!in.object_begin()) {
+                    fail_read(in, start, Reader::Kind::object);
+                    return fail_in(row);
+                }
+                if (!decode_record(in, cpp_val, row, std::make_index_sequence<field_count<T>>{})) return fail_in(row);
+            }
+            return !in.failed() || fail(Errc::syntax);
+        }
+
+    private:
+        template<std::size_t I>
+        static bool decode_member(Reader& in, Columns<T>& cpp_val, std::size_t row) {
+            auto& col = cpp_val.template column<I>();
+            using MemberType = typename std::decay_t<decltype(col)>::value_type;
+            return with_element(col, row, [&](MemberType& val) {
+                return Decoder<MemberType>::decode(in, val) || fail_in(std::get<I>(field_table<T>()).name);
+            });
+        }
+
+        template<std::size_t I>
+        static bool default_member(Columns<T>& cpp_val, std::size_t row) {
+            auto& col = cpp_val.template column<I>();
+            using MemberType = typename std::decay_t<decltype(col)>::value_type;
+            return with_element(col, row, [&](MemberType& val) { return std::get<I>(field_table<T>()).default_into(val); });
+        }
+
+        // As Decoder<T> does for one object, into row of the columns.
+        template<std::size_t... Is>
+        static bool decode_record(Reader& in, Columns<T>& cpp_val, std::size_t row, std::index_sequence<Is...>) {
+            using MemberDecoder = bool (*)(Reader&, Columns<T>&, std::size_t);
+            static constexpr MemberDecoder decoders[] = {&decode_member<Is>..., nullptr};
+            const auto& index = FieldIndex<T>::get();
+
+            std::array<bool, sizeof...(Is)> seen{};
+            std::string_view key;
+            while (in.next_key(key)) {
+                const std::size_t i = index.find(key);
+                if (i == FieldIndex<T>::npos) {
+                    // Skipping reuses the scratch buffer an escaped key is in.
+                    const std::string kept = in.in_scratch(key) ? std::string(key) : std::string();
+                    if (!in.skip()) {
+                        fail(Errc::syntax);
+                        return fail_in(kept.empty() ? key : kept);
+                    }
+                } else {
+                    seen[i] = true;
+                    if (!decoders[i](in, cpp_val, row)) return false;
+                }
+            }
+            if (in.failed()) return fail(Errc::syntax);
+            FirstError success;
+            ((success &= seen[Is] || default_member<Is>(cpp_val, row)), ...);
+            return success.result();
+        }
+    };
+
+    // Written exactly as the same records in a std::vector<T> would be.
+    template<typename T>
+    struct Encoder<Columns<T>, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const Columns<T>& cpp_val) {
+            static const auto encoders = row_encoders<Writer>(std::make_index_sequence<field_count<T>>{});
+            out.array_begin(cpp_val.empty());
+            for (std::size_t row = 0; row < cpp_val.size(); ++row) {
+                out.element(row == 0);
+                out.object_begin(false);
+                bool first = true;
+                for (const auto& [name, encode_field] : encoders) {
+                    out.key(name, first);
+                    first = false;
+                    encode_field(out, cpp_val, row);
+                }
+                out.object_end(false);
+            }
+            out.array_end(cpp_val.empty());
+        }
+
+    private:
+        template<typename Writer, std::size_t I>
+        static void encode_member(Writer& out, const Columns<T>& cpp_val, std::size_t row) {
+            const auto& col = cpp_val.template column<I>();
+            Encoder<typename std::decay_t<decltype(col)>::value_type>::encode(out, col[row]);
+        }
+
+        // Name and encoder of each field, in the sorted key order the DOM
+        // libraries write.
+        template<typename Writer, std::size_t... Is>
+        static auto row_encoders(std::index_sequence<Is...>) {
+            using RowEncoder = void (*)(Writer&, const Columns<T>&, std::size_t);
+            std::array<std::pair<const char*, RowEncoder>, sizeof...(Is)> encoders{
+                std::make_pair(std::get<Is>(field_table<T>()).name, &encode_member<Writer, Is>)...};
+            std::sort(encoders.begin(), encoders.end(),
+                      [](const auto& a, const auto& b) { return std::string_view(a.first) < std::string_view(b.first); });
+            return encoders;
+        }
+    };
+}
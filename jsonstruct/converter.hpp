@@ -1,10 +1,24 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
+#include <tuple>
 #include <optional>   // C++17
 #include <variant> // C++17
 
+#include <jsonstruct/enum.hpp>
+#include <jsonstruct/hash.hpp>
+#include <jsonstruct/field.hpp>
+#include <jsonstruct/numeric.hpp>
+
 namespace jsonstruct {
 
     // Make sure this forward declaration has the new template parameter
@@ -12,54 +26,133 @@ namespace jsonstruct {
     struct Converter;
 
     // --- Basic Type Specializations (now templated on JsonLibTraits) ---
-    template<typename JsonLibTraits>
-    struct Converter<int, JsonLibTraits, void> {
+
+    // Every integral type but bool.  The integer is read as the library
+    // holds it, 64 bits wide, and narrowed with a range check: a number
+    // the type can not hold fails as out_of_range, never wraps.
+    template<typename T, typename JsonLibTraits>
+    struct Converter<T, JsonLibTraits, std::enable_if_t<is_number_type<T>::value && std::is_integral_v<T>>> {
         using JsonValueType = typename JsonLibTraits::ValueType;
-        static bool fromJson(const JsonValueType& j_val, int& cpp_val) {
-            if (JsonLibTraits::is_int(j_val)) { cpp_val = JsonLibTraits::get_int(j_val); return true; }
-            return false;
+        static bool fromJson(const JsonValueType& j_val, T& cpp_val) {
+            if constexpr (std::is_signed_v<T>) {
+                std::int64_t val;
+                if (JsonLibTraits::get_int64(j_val, val)) return narrow(val, cpp_val);
+            } else {
+                std::uint64_t val;
+                if (JsonLibTraits::get_uint64(j_val, val)) return narrow(val, cpp_val);
+            }
+            return fail(JsonLibTraits::is_integer(j_val) ? Errc::out_of_range : Errc::type_mismatch);
+        }
+        static JsonValueType toJson(const T& cpp_val) {
+            if constexpr (std::is_signed_v<T>) return JsonLibTraits::create_int64(cpp_val);
+            else return JsonLibTraits::create_uint64(cpp_val);
         }
-        static JsonValueType toJson(const int& cpp_val) { return JsonLibTraits::create_int(cpp_val); }
     };
-    // Add specializations for std::string, bool, double, etc.
-    template<typename JsonLibTraits>
-    struct Converter<std::string, JsonLibTraits, void> {
+
+    // float, double and long double.  Any JSON number is accepted, an
+    // integer being promoted; a value beyond a float's range is
+    // out_of_range.  Values are held as double in the JSON libraries.
+    template<typename T, typename JsonLibTraits>
+    struct Converter<T, JsonLibTraits, std::enable_if_t<std::is_floating_point_v<T>>> {
         using JsonValueType = typename JsonLibTraits::ValueType;
-        static bool fromJson(const JsonValueType& j_val, std::string& cpp_val) {
-            if (JsonLibTraits::is_string(j_val)) { cpp_val = JsonLibTraits::get_string(j_val); return true; }
-            return false;
+        static bool fromJson(const JsonValueType& j_val, T& cpp_val) {
+            if (!JsonLibTraits::is_number(j_val)) return fail(Errc::type_mismatch);
+            return narrow(JsonLibTraits::get_double(j_val), cpp_val);
         }
-        static JsonValueType toJson(const std::string& cpp_val) { return JsonLibTraits::create_string(cpp_val); }
+        static JsonValueType toJson(const T& cpp_val) { return JsonLibTraits::create_double(static_cast<double>(cpp_val)); }
     };
 
-    template<typename JsonLibTraits>
-    struct Converter<bool, JsonLibTraits, void> {
+    // Enums with json_enum_names() (see enum.hpp): the name, or the
+    // underlying integer for a value without one.
+    template<typename E, typename JsonLibTraits>
+    struct Converter<E, JsonLibTraits, std::enable_if_t<has_enum_names<E>::value>> {
         using JsonValueType = typename JsonLibTraits::ValueType;
-        static bool fromJson(const JsonValueType& j_val, bool& cpp_val) {
-            if (JsonLibTraits::is_bool(j_val)) { cpp_val = JsonLibTraits::get_bool(j_val); return true; }
-            return false;
+        using Underlying = std::underlying_type_t<E>;
+        static bool fromJson(const JsonValueType& j_val, E& cpp_val) {
+            if (JsonLibTraits::is_string(j_val)) return enum_from_name(JsonLibTraits::get_string_view(j_val), cpp_val);
+            Underlying bits{};
+            if (!Converter<Underlying, JsonLibTraits>::fromJson(j_val, bits)) return false;
+            cpp_val = static_cast<E>(bits);
+            return true;
+        }
+        static JsonValueType toJson(const E& cpp_val) {
+            if (const char* name = EnumNames<E>::name(cpp_val)) return JsonLibTraits::create_static_string(name);
+            return Converter<Underlying, JsonLibTraits>::toJson(static_cast<Underlying>(cpp_val));
         }
-        static JsonValueType toJson(const bool& cpp_val) { return JsonLibTraits::create_bool(cpp_val); }
     };
 
+    // Flag sets with json_flag_names(): an array of flag names, and of
+    // integers for bits without a name.
+    template<typename E, typename JsonLibTraits>
+    struct Converter<E, JsonLibTraits, std::enable_if_t<has_flag_names<E>::value>> {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        using Underlying = std::underlying_type_t<E>;
+        static bool fromJson(const JsonValueType& j_val, E& cpp_val) {
+            if (!JsonLibTraits::is_array(j_val)) return fail(Errc::type_mismatch);
+            Underlying bits = 0;
+            std::size_t index = 0;
+            for (const auto& item : j_val) {
+                Underlying more = 0;
+                const bool ok = JsonLibTraits::is_string(item)
+                    ? add_flag<E>(JsonLibTraits::get_string_view(item), more)
+                    : Converter<Underlying, JsonLibTraits>::fromJson(item, more);
+                if (!ok) return fail_in(index);
+                bits |= more;
+                ++index;
+            }
+            cpp_val = static_cast<E>(bits);
+            return true;
+        }
+        static JsonValueType toJson(const E& cpp_val) {
+            JsonValueType j_arr = JsonLibTraits::create_array();
+            const Underlying rest = EnumNames<E>::for_each_flag(cpp_val, [&](const char* name) {
+                JsonLibTraits::append_array_element(j_arr, JsonLibTraits::create_static_string(name));
+            });
+            if (rest) JsonLibTraits::append_array_element(j_arr, Converter<Underlying, JsonLibTraits>::toJson(rest));
+            return j_arr;
+        }
+    };
 
+    // Borrows the string from the JSON value, which must outlive it.  No
+    // allocation or copy at all.
     template<typename JsonLibTraits>
-    struct Converter<double, JsonLibTraits, void> {
+    struct Converter<std::string_view, JsonLibTraits, void> {
         using JsonValueType = typename JsonLibTraits::ValueType;
-        static bool fromJson(const JsonValueType& j_val, double& cpp_val) {
-            // Nlohmann::json differentiates between integer and float numbers,
-            // so checking for either might be appropriate depending on exact requirements.
-            // JsonCPP's isDouble covers both for numbers.
-            if (JsonLibTraits::is_double(j_val)) { cpp_val = JsonLibTraits::get_double(j_val); return true; }
-            // Potentially handle integers as doubles if your policy allows:
-            // if (JsonLibTraits::is_int(j_val)) { cpp_val = static_cast<double>(JsonLibTraits::get_int(j_val)); return true; }
-            return false;
+        static bool fromJson(const JsonValueType& j_val, std::string_view& cpp_val) {
+            if (!JsonLibTraits::is_string(j_val)) return fail(Errc::type_mismatch);
+            cpp_val = JsonLibTraits::get_string_view(j_val);
+            return true;
         }
-        static JsonValueType toJson(const double& cpp_val) { return JsonLibTraits::create_double(cpp_val); }
+        static JsonValueType toJson(const std::string_view& cpp_val) { return JsonLibTraits::create_string(cpp_val); }
     };
 
+    // Any allocator, so std::pmr::string works.  The bytes are copied
+    // straight from the JSON value into cpp_val's own storage.
+    template<typename Alloc, typename JsonLibTraits>
+    struct Converter<std::basic_string<char, std::char_traits<char>, Alloc>, JsonLibTraits, void> {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        using String = std::basic_string<char, std::char_traits<char>, Alloc>;
+        static bool fromJson(const JsonValueType& j_val, String& cpp_val) {
+            if (!JsonLibTraits::is_string(j_val)) return fail(Errc::type_mismatch);
+            const std::string_view str = JsonLibTraits::get_string_view(j_val);
+            cpp_val.assign(str.data(), str.size());
+            return true;
+        }
+        static JsonValueType toJson(const String& cpp_val) {
+            return JsonLibTraits::create_string(std::string_view(cpp_val));
+        }
+    };
+
+    template<typename JsonLibTraits>
+    struct Converter<bool, JsonLibTraits, void> {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        static bool fromJson(const JsonValueType& j_val, bool& cpp_val) {
+            if (JsonLibTraits::is_bool(j_val)) { cpp_val = JsonLibTraits::get_bool(j_val); return true; }
+            return fail(Errc::type_mismatch);
+        }
+        static JsonValueType toJson(const bool& cpp_val) { return JsonLibTraits::create_bool(cpp_val); }
+    };
 
-    // ... other primitive types ...
 
     template<typename T>
     struct has_config_fields {
@@ -71,87 +164,277 @@ namespace jsonstruct {
         static constexpr bool value = decltype(test((T*)nullptr))::value;
     };
 
+    // The field descriptors of T, built once on first use and shared after
+    // that (thread-safe).  Converters use this rather than calling
+    // T::config_fields() so that descriptors, and any defaults they hold,
+    // are not rebuilt and destroyed on every conversion.
+    template<typename T>
+    const auto& field_table() {
+        static const auto table = T::config_fields();
+        return table;
+    }
 
+    template<typename T>
+    constexpr std::size_t field_count = std::tuple_size_v<std::decay_t<decltype(T::config_fields())>>;
+
+    // Call func(field) on the field at a runtime index of a config_fields() tuple.
+    template<typename Fields, typename Func>
+    void visit_field(const Fields& fields, std::size_t index, Func&& func) {
+        std::apply([&](const auto&... field) {
+            std::size_t i = 0;
+            ((i++ == index ? (func(field), true) : false) || ...);
+        }, fields);
+    }
 
-    template<typename StructType, typename MemberType> // Removed JsonLibTraits from Field struct itself
-    struct Field {
-        const char* name;
-        MemberType StructType::* ptr_to_member;
-        std::optional<MemberType> default_value;
-        bool is_required;
+    // Maps a JSON key to the index of T's field of that name with a perfect
+    // hash over the field names.  The names are only known once
+    // config_fields() has run, so the hash seed and table are found on
+    // first use, once per type, rather than at compile time.
+    template<typename T>
+    class FieldIndex {
+    public:
+        static constexpr std::size_t npos = field_count<T>;
 
-        Field(const char* n, MemberType StructType::* p)
-            : name(n), ptr_to_member(p), is_required(true) {}
+        static const FieldIndex& get() {
+            static const FieldIndex index;
+            return index;
+        }
 
-        Field(const char* n, MemberType StructType::* p, const MemberType& default_val)
-            : name(n), ptr_to_member(p), default_value(default_val), is_required(false) {}
+        // Index of the field named key, or npos.
+        std::size_t find(std::string_view key) const {
+            const Slot& slot = slots_[name_hash(key, seed_) & mask_];
+            return slot.name == key ? slot.index : npos;
+        }
 
-        // Template parse and serialize methods on JsonLibTraits
-        template<typename JsonLibTraits>
-        bool parse(StructType& obj, const typename JsonLibTraits::ValueType& parent_json) const {
-            if (JsonLibTraits::has_member(parent_json, name)) {
-                // Use the generic Converter with the specified JsonLibTraits
-                return Converter<MemberType, JsonLibTraits, void>::fromJson(
-                    JsonLibTraits::get_member(parent_json, name), obj.*ptr_to_member);
-            } else {
-                if (default_value) {
-                    obj.*ptr_to_member = *default_value;
-                    return true;
-                }
-                if (is_required) {
-                    return false;
+    private:
+        struct Slot {
+            std::string_view name;
+            std::size_t index = npos;
+        };
+
+        FieldIndex() {
+            std::array<std::string_view, field_count<T>> names;
+            std::apply([&](const auto&... field) {
+                std::size_t i = 0;
+                ((names[i++] = field.name), ...);
+            }, field_table<T>());
+
+            // Search for a collision-free seed, growing the table if needed.
+            for (std::size_t size = 2; ; size *= 2) {
+                if (size < 2 * names.size()) continue;
+                for (std::uint64_t seed = 0; seed < 256; ++seed) {
+                    slots_.assign(size, Slot{});
+                    bool perfect = true;
+                    for (std::size_t i = 0; i < names.size() && perfect; ++i) {
+                        Slot& slot = slots_[name_hash(names[i], seed) & (size - 1)];
+                        if (slot.index != npos && slot.name != names[i]) perfect = false;
+                        else if (slot.index == npos) slot = Slot{names[i], i};
+                    }
+                    if (perfect) {
+                        seed_ = seed;
+                        mask_ = size - 1;
+                        return;
+                    }
                 }
-                return true;
             }
         }
 
-        template<typename JsonLibTraits>
-        void serialize(const StructType& obj, typename JsonLibTraits::ValueType& parent_json) const {
-            // Use the generic Converter with the specified JsonLibTraits
-            JsonLibTraits::set_member(
-                parent_json, name,
-                Converter<MemberType, JsonLibTraits, void>::toJson(obj.*ptr_to_member));
-        }
+        std::vector<Slot> slots_;
+        std::uint64_t seed_{0};
+        std::size_t mask_{0};
     };
 
-    // Helper functions for cleaner Field creation (no change needed here)
-    template<typename StructType, typename MemberType>
-    Field<StructType, MemberType> make_field(const char* name, MemberType StructType::* ptr) {
-        return Field<StructType, MemberType>(name, ptr);
-    }
+    // How the struct Converter matches JSON members to fields:
+    //
+    // - lookup: one find_member() per declared field.  Cost grows with the
+    //   number of fields declared.
+    //
+    // - dispatch: one pass over the members actually present, each key
+    //   sent to its field through FieldIndex<T>.  Cost grows with the size
+    //   of the document.  Faster unless documents carry many members which
+    //   T does not declare (see bench_jsonstruct).
+    //
+    // A struct opts in with `static constexpr auto json_decode = Decode::dispatch;`.
+    enum class Decode { lookup, dispatch };
+
+    template<typename T, typename Enable = void>
+    struct decode_strategy : std::integral_constant<Decode, Decode::lookup> {};
 
-    template<typename StructType, typename MemberType>
-    Field<StructType, MemberType> make_field(const char* name, MemberType StructType::* ptr, const MemberType& default_val) {
-        return Field<StructType, MemberType>(name, ptr, default_val);
-    }
+    template<typename T>
+    struct decode_strategy<T, std::void_t<decltype(T::json_decode)>>
+        : std::integral_constant<Decode, T::json_decode> {};
 
 
 
     // --- Container Type Specializations (e.g., std::vector) ---
-    template<typename T_elem, typename JsonLibTraits>
-    struct Converter<std::vector<T_elem>, JsonLibTraits, void> {
+    //
+    // Elements are converted in place in the container, never through a
+    // temporary, and JSON nodes built by toJson are moved into the parent.
+
+    // Numbers which std::vector converts in bulk through the Traits'
+    // get_numbers()/create_numbers() instead of element by element.
+    template<typename T>
+    struct is_bulk_number : is_number_type<T> {};
+
+    // Containers with contiguous storage the bulk path can write into.
+    template<typename C, typename = void>
+    struct has_data : std::false_type {};
+    template<typename C>
+    struct has_data<C, std::void_t<decltype(std::declval<C&>().data())>> : std::true_type {};
+
+    // Shared by the sequence containers: vector, deque.
+    template<typename Container, typename JsonLibTraits>
+    struct SequenceConverter {
         using JsonValueType = typename JsonLibTraits::ValueType;
-        static bool fromJson(const JsonValueType& j_val, std::vector<T_elem>& cpp_val) {
-            if (!JsonLibTraits::is_array(j_val)) return false;
+        using T_elem = typename Container::value_type;
+        static constexpr bool bulk = is_bulk_number<T_elem>::value && has_data<Container>::value;
+
+        static bool fromJson(const JsonValueType& j_val, Container& cpp_val) {
+            if constexpr (bulk) {
+                if (!JsonLibTraits::is_array(j_val)) return fail(Errc::type_mismatch);
+                cpp_val.resize(JsonLibTraits::array_size(j_val));
+                if (JsonLibTraits::get_numbers(j_val, cpp_val.data())) return true;
+                // Again element by element, which accepts the same, to
+                // find the element at fault.
+                if (fromJsonEach(j_val, cpp_val)) return true;
+                cpp_val.clear();
+                return false;
+            } else {
+                return fromJsonEach(j_val, cpp_val);
+            }
+        }
+
+        static JsonValueType toJson(const Container& cpp_val) {
+            if constexpr (bulk) {
+                return JsonLibTraits::create_numbers(cpp_val.data(), cpp_val.size());
+            } else {
+                return toJsonEach(cpp_val);
+            }
+        }
+
+        // The general path, one Converter call per element.
+        static bool fromJsonEach(const JsonValueType& j_val, Container& cpp_val) {
+            if (!JsonLibTraits::is_array(j_val)) return fail(Errc::type_mismatch);
             cpp_val.clear();
-            bool success = true;
+            if constexpr (has_reserve<Container>::value) {
+                cpp_val.reserve(JsonLibTraits::array_size(j_val));
+            }
             // This loop works for JsonCpp and nlohmann::json if j_val is iterable
             for (const auto& item : j_val) {
-                T_elem elem;
-                if (!Converter<T_elem, JsonLibTraits, void>::fromJson(item, elem)) { success = false; break; }
-                cpp_val.push_back(elem);
+                Scope scope(any_element, Phase::decode);
+                if constexpr (std::is_same_v<T_elem, bool>) {
+                    // std::vector<bool> has no bool& to convert into.
+                    bool elem;
+                    if (!Converter<bool, JsonLibTraits, void>::fromJson(item, elem)) return fail_in(cpp_val.size());
+                    cpp_val.push_back(elem);
+                } else {
+                    cpp_val.emplace_back();
+                    if (!Converter<T_elem, JsonLibTraits, void>::fromJson(item, cpp_val.back())) {
+                        cpp_val.pop_back();
+                        return fail_in(cpp_val.size());
+                    }
+                }
             }
-            return success;
+            return true;
+        }
+
+        static JsonValueType toJsonEach(const Container& cpp_val) {
+            JsonValueType arr = JsonLibTraits::create_array();
+            JsonLibTraits::reserve_array(arr, cpp_val.size());
+            for (const auto& elem : cpp_val) {
+                Scope scope(any_element, Phase::encode);
+                JsonLibTraits::append_array_element(arr, Converter<T_elem, JsonLibTraits, void>::toJson(elem));
+            }
+            return arr;
+        }
+
+    private:
+        using Scope = typename instrumentation_t<JsonLibTraits>::Scope;
+
+        template<typename C, typename = void>
+        struct has_reserve : std::false_type {};
+        template<typename C>
+        struct has_reserve<C, std::void_t<decltype(std::declval<C&>().reserve(std::size_t{}))>> : std::true_type {};
+    };
+
+    template<typename T_elem, typename Alloc, typename JsonLibTraits>
+    struct Converter<std::vector<T_elem, Alloc>, JsonLibTraits, void>
+        : SequenceConverter<std::vector<T_elem, Alloc>, JsonLibTraits> {};
+
+    template<typename T_elem, typename Alloc, typename JsonLibTraits>
+    struct Converter<std::deque<T_elem, Alloc>, JsonLibTraits, void>
+        : SequenceConverter<std::deque<T_elem, Alloc>, JsonLibTraits> {};
+
+    // A JSON array of exactly N elements.
+    template<typename T_elem, std::size_t N, typename JsonLibTraits>
+    struct Converter<std::array<T_elem, N>, JsonLibTraits, void> {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        static bool fromJson(const JsonValueType& j_val, std::array<T_elem, N>& cpp_val) {
+            if (!JsonLibTraits::is_array(j_val) || JsonLibTraits::array_size(j_val) != N) return fail(Errc::type_mismatch);
+            std::size_t i = 0;
+            for (const auto& item : j_val) {
+                Scope scope(any_element, Phase::decode);
+                if (!Converter<T_elem, JsonLibTraits, void>::fromJson(item, cpp_val[i])) return fail_in(i);
+                ++i;
+            }
+            return true;
         }
-        static JsonValueType toJson(const std::vector<T_elem>& cpp_val) {
+        static JsonValueType toJson(const std::array<T_elem, N>& cpp_val) {
             JsonValueType arr = JsonLibTraits::create_array();
+            JsonLibTraits::reserve_array(arr, N);
             for (const auto& elem : cpp_val) {
+                Scope scope(any_element, Phase::encode);
                 JsonLibTraits::append_array_element(arr, Converter<T_elem, JsonLibTraits, void>::toJson(elem));
             }
             return arr;
         }
+
+    private:
+        using Scope = typename instrumentation_t<JsonLibTraits>::Scope;
     };
 
+    // Shared by the string-keyed maps: a JSON object with arbitrary keys.
+    template<typename Map, typename JsonLibTraits>
+    struct MapConverter {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        using T_val = typename Map::mapped_type;
+
+        static bool fromJson(const JsonValueType& j_val, Map& cpp_val) {
+            if (!JsonLibTraits::is_object(j_val)) return fail(Errc::type_mismatch);
+            cpp_val.clear();
+            bool success = true;
+            using Key = typename Map::key_type;
+            JsonLibTraits::for_each_object_member(j_val, [&](std::string_view key, const JsonValueType& item) {
+                if (!success) return;
+                Scope scope(any_element, Phase::decode);
+                // Keys get the map's allocator from the start.
+                auto it = cpp_val.try_emplace(Key(key, typename Key::allocator_type(cpp_val.get_allocator()))).first;
+                success = Converter<T_val, JsonLibTraits, void>::fromJson(item, it->second) || fail_in(key);
+            });
+            return success;
+        }
+
+        static JsonValueType toJson(const Map& cpp_val) {
+            JsonValueType obj = JsonLibTraits::create_object();
+            for (const auto& [key, val] : cpp_val) {
+                Scope scope(any_element, Phase::encode);
+                JsonLibTraits::set_member(obj, key.c_str(), Converter<T_val, JsonLibTraits, void>::toJson(val));
+            }
+            return obj;
+        }
+
+    private:
+        using Scope = typename instrumentation_t<JsonLibTraits>::Scope;
+    };
+
+    template<typename KeyAlloc, typename T_val, typename Compare, typename Alloc, typename JsonLibTraits>
+    struct Converter<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>, JsonLibTraits, void>
+        : MapConverter<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>, JsonLibTraits> {};
+
+    template<typename KeyAlloc, typename T_val, typename Hash, typename Equal, typename Alloc, typename JsonLibTraits>
+    struct Converter<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>, JsonLibTraits, void>
+        : MapConverter<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>, JsonLibTraits> {};
+
     // --- std::optional Specialization ---
     template<typename T_val, typename JsonLibTraits>
     struct Converter<std::optional<T_val>, JsonLibTraits, void> {
@@ -161,9 +444,8 @@ namespace jsonstruct {
                 cpp_val.reset();
                 return true;
             }
-            T_val temp_val;
-            if (Converter<T_val, JsonLibTraits, void>::fromJson(j_val, temp_val)) {
-                cpp_val = std::move(temp_val);
+            if (!cpp_val) cpp_val.emplace();
+            if (Converter<T_val, JsonLibTraits, void>::fromJson(j_val, *cpp_val)) {
                 return true;
             }
             cpp_val.reset();
@@ -177,66 +459,340 @@ namespace jsonstruct {
         }
     };
 
-    // --- std::variant Specialization ---
-    template<typename... Types, typename JsonLibTraits>
-    struct Converter<std::variant<Types...>, JsonLibTraits, void> {
+    // --- Smart pointers: null or the pointee ---
+    template<typename T_val, typename JsonLibTraits>
+    struct Converter<std::unique_ptr<T_val>, JsonLibTraits, void> {
         using JsonValueType = typename JsonLibTraits::ValueType;
+        static bool fromJson(const JsonValueType& j_val, std::unique_ptr<T_val>& cpp_val) {
+            if (JsonLibTraits::is_null(j_val)) {
+                cpp_val.reset();
+                return true;
+            }
+            if (!cpp_val) cpp_val = std::make_unique<T_val>();   // else reuse the pointee
+            if (Converter<T_val, JsonLibTraits, void>::fromJson(j_val, *cpp_val)) {
+                return true;
+            }
+            cpp_val.reset();
+            return false;
+        }
+        static JsonValueType toJson(const std::unique_ptr<T_val>& cpp_val) {
+            if (cpp_val) {
+                return Converter<T_val, JsonLibTraits, void>::toJson(*cpp_val);
+            }
+            return JsonLibTraits::create_null();
+        }
+    };
 
-        static bool fromJson(const JsonValueType& j_val, std::variant<Types...>& cpp_val) {
-            bool success = false;
+    template<typename T_val, typename JsonLibTraits>
+    struct Converter<std::shared_ptr<T_val>, JsonLibTraits, void> {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        static bool fromJson(const JsonValueType& j_val, std::shared_ptr<T_val>& cpp_val) {
+            if (JsonLibTraits::is_null(j_val)) {
+                cpp_val.reset();
+                return true;
+            }
+            // A fresh pointee: the old one may be shared with other owners.
+            auto fresh = std::make_shared<T_val>();
+            if (!Converter<T_val, JsonLibTraits, void>::fromJson(j_val, *fresh)) {
+                cpp_val.reset();
+                return false;
+            }
+            cpp_val = std::move(fresh);
+            return true;
+        }
+        static JsonValueType toJson(const std::shared_ptr<T_val>& cpp_val) {
+            if (cpp_val) {
+                return Converter<T_val, JsonLibTraits, void>::toJson(*cpp_val);
+            }
+            return JsonLibTraits::create_null();
+        }
+    };
 
-            auto try_parse_single_type = [&](auto dummy_instance) {
-                using CurrentType = decltype(dummy_instance);
+    // --- JSON kinds, for ruling out variant alternatives cheaply ---
+    //
+    // json_kinds<T>::value is the set of JSON kinds which T's converters can
+    // possibly accept.  A value of any other kind is rejected without
+    // building a T.  Types not listed here claim every kind.
+    enum JsonKind : unsigned {
+        kind_null = 1u << 0,
+        kind_boolean = 1u << 1,
+        kind_integer = 1u << 2,
+        kind_real = 1u << 3,
+        kind_string = 1u << 4,
+        kind_array = 1u << 5,
+        kind_object = 1u << 6,
+        kind_number = kind_integer | kind_real,
+        kind_any = (1u << 7) - 1
+    };
 
-                if (!success) {
-                    CurrentType temp_value;
-                    if (Converter<CurrentType, JsonLibTraits, void>::fromJson(j_val, temp_value)) {
-                        cpp_val = std::move(temp_value);
-                        success = true;
-                    }
-                }
-            };
+    template<typename T, typename Enable = void>
+    struct json_kinds : std::integral_constant<unsigned, kind_any> {};
+    template<typename T>
+    struct json_kinds<T, std::enable_if_t<is_number_type<T>::value>>
+        : std::integral_constant<unsigned, std::is_integral_v<T> ? kind_integer : kind_number> {};
+    template<typename E>
+    struct json_kinds<E, std::enable_if_t<has_enum_names<E>::value>> : std::integral_constant<unsigned, kind_string | kind_integer> {};
+    template<typename E>
+    struct json_kinds<E, std::enable_if_t<has_flag_names<E>::value>> : std::integral_constant<unsigned, kind_array> {};
+    template<>
+    struct json_kinds<bool> : std::integral_constant<unsigned, kind_boolean> {};
+    template<typename Alloc>
+    struct json_kinds<std::basic_string<char, std::char_traits<char>, Alloc>> : std::integral_constant<unsigned, kind_string> {};
+    template<>
+    struct json_kinds<std::string_view> : std::integral_constant<unsigned, kind_string> {};
+    template<typename T_elem, typename Alloc>
+    struct json_kinds<std::vector<T_elem, Alloc>> : std::integral_constant<unsigned, kind_array> {};
+    template<typename T_elem, typename Alloc>
+    struct json_kinds<std::deque<T_elem, Alloc>> : std::integral_constant<unsigned, kind_array> {};
+    template<typename T_elem, std::size_t N>
+    struct json_kinds<std::array<T_elem, N>> : std::integral_constant<unsigned, kind_array> {};
+    template<typename Key, typename T_val, typename Compare, typename Alloc>
+    struct json_kinds<std::map<Key, T_val, Compare, Alloc>> : std::integral_constant<unsigned, kind_object> {};
+    template<typename Key, typename T_val, typename Hash, typename Equal, typename Alloc>
+    struct json_kinds<std::unordered_map<Key, T_val, Hash, Equal, Alloc>> : std::integral_constant<unsigned, kind_object> {};
+    // Null, and the empty {} and [] which also mean "no value".
+    template<typename T_val>
+    struct json_kinds<std::optional<T_val>>
+        : std::integral_constant<unsigned, kind_null | kind_object | kind_array | json_kinds<T_val>::value> {};
+    template<typename T_val>
+    struct json_kinds<std::unique_ptr<T_val>> : std::integral_constant<unsigned, kind_null | json_kinds<T_val>::value> {};
+    template<typename T_val>
+    struct json_kinds<std::shared_ptr<T_val>> : std::integral_constant<unsigned, kind_null | json_kinds<T_val>::value> {};
+    template<typename... Types>
+    struct json_kinds<std::variant<Types...>> : std::integral_constant<unsigned, (json_kinds<Types>::value | ... | 0u)> {};
+    template<typename T>
+    struct json_kinds<T, std::enable_if_t<has_config_fields<T>::value>> : std::integral_constant<unsigned, kind_object> {};
 
-            // FIX: Use an initializer list to correctly expand the pack
-            int dummy_array[] = {
-                (try_parse_single_type(Types{}), 0)... // The '...' applies to the whole (expression, 0) part
-            };
-            (void)dummy_array; // Suppress unused variable warning
+    // The kind of a JSON value, as the Traits' predicates see it.
+    template<typename JsonLibTraits>
+    unsigned kind_of(const typename JsonLibTraits::ValueType& v) {
+        if (JsonLibTraits::is_object(v)) return kind_object;
+        if (JsonLibTraits::is_array(v)) return kind_array;
+        if (JsonLibTraits::is_string(v)) return kind_string;
+        if (JsonLibTraits::is_bool(v)) return kind_boolean;
+        if (JsonLibTraits::is_null(v)) return kind_null;
+        if (JsonLibTraits::is_integer(v)) return kind_integer;
+        return kind_real;
+    }
 
-            return success;
+    // --- Borrowing, for decoders which do not keep the text ---
+    //
+    // borrows_text<T>() is true if a T decoded from text may point into it:
+    // T is a std::string_view, or holds one through its fields, elements,
+    // map keys or values, optional, pointer or variant alternatives.  Seen
+    // is a std::tuple of the structs being looked through, so that
+    // recursive ones end.
+    template<typename T, typename Seen = std::tuple<>>
+    constexpr bool borrows_text();
+
+    template<typename T, typename = void>
+    struct has_element_type : std::false_type {};
+    template<typename T>
+    struct has_element_type<T, std::void_t<typename T::element_type>> : std::true_type {};
+    template<typename T, typename = void>
+    struct has_value_type : std::false_type {};
+    template<typename T>
+    struct has_value_type<T, std::void_t<typename T::value_type>> : std::true_type {};
+
+    template<typename T, typename... Seen>
+    constexpr bool seen_in(std::tuple<Seen...>*) { return (std::is_same_v<T, Seen> || ...); }
+    template<typename T, typename... Seen>
+    std::tuple<T, Seen...>* also_seen(std::tuple<Seen...>*);
+
+    template<typename Seen, typename S, typename... Members>
+    constexpr bool parts_borrow(std::tuple<Field<S, Members>...>*) { return (borrows_text<Members, Seen>() || ...); }
+    template<typename Seen, typename... Types>
+    constexpr bool parts_borrow(std::variant<Types...>*) { return (borrows_text<Types, Seen>() || ...); }
+    template<typename Seen, typename Key, typename T_val>
+    constexpr bool parts_borrow(std::pair<Key, T_val>*) {
+        return borrows_text<std::remove_const_t<Key>, Seen>() || borrows_text<T_val, Seen>();
+    }
+    // Containers, std::optional and the smart pointers.
+    template<typename Seen, typename T>
+    constexpr bool parts_borrow(T*) {
+        if constexpr (has_element_type<T>::value) return borrows_text<typename T::element_type, Seen>();
+        else if constexpr (has_value_type<T>::value) return borrows_text<typename T::value_type, Seen>();
+        else return false;
+    }
+
+    template<typename T, typename Seen>
+    constexpr bool borrows_text() {
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            return true;
+        } else if constexpr (has_config_fields<T>::value) {
+            if constexpr (seen_in<T>(static_cast<Seen*>(nullptr))) {
+                return false;
+            } else {
+                using Fields = std::decay_t<decltype(T::config_fields())>;
+                using Next = std::remove_pointer_t<decltype(also_seen<T>(static_cast<Seen*>(nullptr)))>;
+                return parts_borrow<Next>(static_cast<Fields*>(nullptr));
+            }
+        } else {
+            return parts_borrow<Seen>(static_cast<T*>(nullptr));
+        }
+    }
+
+    // Tagged variants.  When every alternative declares
+    //
+    //     static constexpr const char* json_tag = "circle";
+    //
+    // the variant is written as the alternative's object plus a
+    // discriminator member holding its tag, and read by going straight to
+    // the alternative the tag names.  The member is "type" unless the
+    // alternatives declare json_tag_key.
+    template<typename T, typename = void>
+    struct has_json_tag : std::false_type {};
+    template<typename T>
+    struct has_json_tag<T, std::void_t<decltype(T::json_tag)>> : std::true_type {};
+
+    template<typename T, typename = void>
+    struct json_tag_key { static constexpr const char* value = "type"; };
+    template<typename T>
+    struct json_tag_key<T, std::void_t<decltype(T::json_tag_key)>> { static constexpr const char* value = T::json_tag_key; };
+
+    template<typename... Types>
+    inline constexpr bool is_tagged_variant = sizeof...(Types) > 0 && (has_json_tag<Types>::value && ...);
+
+    template<typename First, typename... Rest>
+    inline constexpr const char* variant_tag_key = json_tag_key<First>::value;
+
+    // --- std::variant Specialization ---
+    //
+    // Untagged, the first alternative which converts wins.  Alternatives
+    // which can not accept the value's kind are skipped unbuilt, and one
+    // already held is converted in place.  So, as with a struct, a failed
+    // conversion may leave the held alternative partly overwritten: holding
+    // A{1, "keep"}, {"x": 7, "s": 5} fails with x already 7.  Others are
+    // built in a temporary and only emplaced once converted.
+    template<typename... Types, typename JsonLibTraits>
+    struct Converter<std::variant<Types...>, JsonLibTraits, void> {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        using Variant = std::variant<Types...>;
+
+        static bool fromJson(const JsonValueType& j_val, Variant& cpp_val) {
+            if constexpr (is_tagged_variant<Types...>) {
+                return fromJsonTagged(j_val, cpp_val);
+            } else {
+                const unsigned kind = kind_of<JsonLibTraits>(j_val);
+                const ErrorMark mark;
+                if (((json_kinds<Types>::value & kind && convert<Types>(j_val, cpp_val)) || ...)) {
+                    mark.restore();
+                    return true;
+                }
+                return fail(Errc::variant_no_match);
+            }
         }
 
-        static JsonValueType toJson(const std::variant<Types...>& cpp_val) {
+        static JsonValueType toJson(const Variant& cpp_val) {
             return std::visit([&](auto&& arg) {
                 using T_current = std::decay_t<decltype(arg)>;
                 // Pass JsonLibTraits in the recursive call
-                return Converter<T_current, JsonLibTraits, void>::toJson(std::forward<decltype(arg)>(arg));
+                JsonValueType j_val = Converter<T_current, JsonLibTraits, void>::toJson(std::forward<decltype(arg)>(arg));
+                if constexpr (is_tagged_variant<Types...>) {
+                    JsonLibTraits::set_member(j_val, variant_tag_key<Types...>,
+                                              JsonLibTraits::create_string(std::string_view(T_current::json_tag)));
+                }
+                return j_val;
             }, cpp_val);
         }
-    };
 
+    private:
+        static bool fromJsonTagged(const JsonValueType& j_val, Variant& cpp_val) {
+            if (!JsonLibTraits::is_object(j_val)) return fail(Errc::type_mismatch);
+            const auto* tag = JsonLibTraits::find_member(j_val, variant_tag_key<Types...>);
+            if (!tag || !JsonLibTraits::is_string(*tag)) {
+                fail(tag ? Errc::type_mismatch : Errc::missing_required);
+                return fail_in(variant_tag_key<Types...>);
+            }
+            const std::string_view name = JsonLibTraits::get_string_view(*tag);
+            bool success = false;
+            if (!((name == Types::json_tag ? (success = convert<Types>(j_val, cpp_val), true) : false) || ...)) {
+                fail(Errc::variant_no_match);
+                return fail_in(variant_tag_key<Types...>);
+            }
+            return success;
+        }
 
+        template<typename Alt>
+        static bool convert(const JsonValueType& j_val, Variant& cpp_val) {
+            if (Alt* held = std::get_if<Alt>(&cpp_val)) {
+                if (Converter<Alt, JsonLibTraits, void>::fromJson(j_val, *held)) return true;
+            } else {
+                Alt temp_value{};
+                if (Converter<Alt, JsonLibTraits, void>::fromJson(j_val, temp_value)) {
+                    cpp_val.template emplace<Alt>(std::move(temp_value));
+                    return true;
+                }
+            }
+            if constexpr (!is_tagged_variant<Types...>) instrumentation_t<JsonLibTraits>::variant_retry();
+            return false;
+        }
+    };
 
     // --- Generic Converter for Custom Structs (SFINAE) ---
     template<typename T, typename JsonLibTraits>
     struct Converter<T, JsonLibTraits, std::enable_if_t<has_config_fields<T>::value>> {
         using JsonValueType = typename JsonLibTraits::ValueType;
         static bool fromJson(const JsonValueType& json_config, T& out_obj) {
-            if (!JsonLibTraits::is_object(json_config)) return false;
-            bool success = true;
-            std::apply([&](const auto&... field_descriptor){
-                ((success &= field_descriptor.template parse<JsonLibTraits>(out_obj, json_config)), ...); // Pass traits
-            }, T::config_fields());
-            return success;
+            if constexpr (decode_strategy<T>::value == Decode::dispatch) {
+                return fromJsonDispatch(json_config, out_obj);
+            } else {
+                return fromJsonLookup(json_config, out_obj);
+            }
+        }
+
+        static bool fromJsonLookup(const JsonValueType& json_config, T& out_obj) {
+            if (!JsonLibTraits::is_object(json_config)) return fail(Errc::type_mismatch);
+            // A failed member outranks a missing one, as on the backends
+            // which default the absent fields after reading the rest.
+            FirstError converted, defaulted;
+            const auto parse = [&](const auto& field) {
+                if (const auto* member_json = JsonLibTraits::find_member(json_config, field.name)) {
+                    converted &= field.template parse_value<JsonLibTraits>(out_obj, *member_json);
+                } else {
+                    defaulted &= field.use_default(out_obj);
+                }
+            };
+            std::apply([&](const auto&... field_descriptor){ (parse(field_descriptor), ...); }, field_table<T>());
+            return converted.result() && defaulted.result();
+        }
+
+        static bool fromJsonDispatch(const JsonValueType& json_config, T& out_obj) {
+            if (!JsonLibTraits::is_object(json_config)) return fail(Errc::type_mismatch);
+            return dispatch(json_config, out_obj, std::make_index_sequence<field_count<T>>{});
         }
 
         static JsonValueType toJson(const T& obj) {
             JsonValueType json_val = JsonLibTraits::create_object();
             std::apply([&](const auto&... field_descriptor){
                 (field_descriptor.template serialize<JsonLibTraits>(obj, json_val), ...); 
-            }, T::config_fields());
+            }, field_table<T>());
             return json_val;
         }
+
+    private:
+        template<std::size_t I>
+        static bool parse_field(const JsonValueType& member_json, T& out_obj) {
+            return std::get<I>(field_table<T>()).template parse_value<JsonLibTraits>(out_obj, member_json);
+        }
+
+        template<std::size_t... Is>
+        static bool dispatch(const JsonValueType& json_config, T& out_obj, std::index_sequence<Is...>) {
+            using Parser = bool (*)(const JsonValueType&, T&);
+            static constexpr Parser parsers[] = {&parse_field<Is>..., nullptr};
+            const auto& index = FieldIndex<T>::get();
+
+            std::array<bool, sizeof...(Is)> seen{};
+            FirstError success;
+            JsonLibTraits::for_each_object_member(json_config, [&](std::string_view key, const JsonValueType& value) {
+                const std::size_t i = index.find(key);
+                if (i == FieldIndex<T>::npos) return;
+                seen[i] = true;
+                success &= parsers[i](value, out_obj);
+            });
+            ((success &= seen[Is] || std::get<Is>(field_table<T>()).use_default(out_obj)), ...);
+            return success.result();
+        }
     };
 
 }
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <jsonstruct/converter.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jsonstruct {
+
+    /// What the JSON of every field looked like when diff_apply() last
+    /// converted it: a hash per field, nested structs' fields included, in
+    /// a fixed order.  Keep one per object being reloaded, and only change
+    /// that object through diff_apply().
+    struct DeltaState {
+        std::vector<std::uint64_t> hashes;
+        std::vector<char> known;    // hashes[i] is valid
+
+        void clear() {
+            hashes.clear();
+            known.clear();
+        }
+    };
+
+    /// The fields which diff_apply() converted again, as JSON pointers
+    /// ("/database/user") in config_fields() order.  Fields of nested
+    /// structs are listed individually; any other field (a container, an
+    /// optional, ...) is listed as a whole.
+    struct ChangeSet {
+        std::vector<std::string> paths;
+        bool ok{true};          // false if a field failed to convert
+
+        bool empty() const { return paths.empty(); }
+
+        /// True if the field at path, or one inside it, changed.
+        bool touches(std::string_view path) const {
+            for (const auto& changed : paths) {
+                if (changed.size() >= path.size() && changed.compare(0, path.size(), path) == 0
+                    && (changed.size() == path.size() || changed[path.size()] == '/' || path.empty())) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    /// A 64-bit hash of a JSON subtree: its kinds, numbers, strings and
+    /// keys in iteration order (which both DOMs keep sorted).  Words are
+    /// mixed in by multiply and xor-shift, eight bytes at a time.
+    template<typename JsonLibTraits>
+    class SubtreeHash {
+    public:
+        using JsonValueType = typename JsonLibTraits::ValueType;
+
+        static std::uint64_t of(const JsonValueType& v) {
+            std::uint64_t h = offset;
+            add(h, v);
+            return h;
+        }
+
+        // Stands for a member which is absent.
+        static constexpr std::uint64_t absent = 0;
+
+    private:
+        static constexpr std::uint64_t offset = 0x243f6a8885a308d3ull;
+        static constexpr std::uint64_t multiplier = 0x9e3779b97f4a7c15ull;
+
+        static void mix(std::uint64_t& h, std::uint64_t word) {
+            h = (h ^ word) * multiplier;
+            h ^= h >> 29;
+        }
+
+        static void bytes(std::uint64_t& h, const char* p, std::size_t n) {
+            std::uint64_t word;
+            for (; n >= 8; p += 8, n -= 8) {
+                std::memcpy(&word, p, 8);
+                mix(h, word);
+            }
+            if (n) {
+                word = 0;
+                std::memcpy(&word, p, n);
+                mix(h, word);
+            }
+        }
+
+        template<typename Scalar>
+        static void scalar(std::uint64_t& h, Scalar x) {
+            std::uint64_t word = 0;
+            std::memcpy(&word, &x, sizeof x);
+            mix(h, word);
+        }
+
+        static void string(std::uint64_t& h, std::string_view s) {
+            scalar(h, s.size());
+            bytes(h, s.data(), s.size());
+        }
+
+        static void add(std::uint64_t& h, const JsonValueType& v) {
+            if (JsonLibTraits::is_object(v)) {
+                scalar(h, 'o');
+                JsonLibTraits::for_each_object_member(v, [&](std::string_view key, const JsonValueType& member) {
+                    string(h, key);
+                    add(h, member);
+                });
+                scalar(h, '}');
+            } else if (JsonLibTraits::is_array(v)) {
+                scalar(h, 'a');
+                for (const auto& element : v) add(h, element);
+                scalar(h, ']');
+            } else if (JsonLibTraits::is_string(v)) {
+                scalar(h, 's');
+                string(h, JsonLibTraits::get_string_view(v));
+            } else if (std::int64_t i; JsonLibTraits::get_int64(v, i)) {
+                scalar(h, 'i');
+                scalar(h, i);
+            } else if (std::uint64_t u; JsonLibTraits::get_uint64(v, u)) {
+                scalar(h, 'u');
+                scalar(h, u);
+            } else if (JsonLibTraits::is_double(v)) {
+                scalar(h, 'd');
+                scalar(h, JsonLibTraits::get_double(v));
+            } else if (JsonLibTraits::is_bool(v)) {
+                scalar(h, JsonLibTraits::get_bool(v) ? 't' : 'f');
+            } else {
+                scalar(h, 'n');
+            }
+        }
+    };
+
+    // Applies one struct's fields, recursing into nested structs so that
+    // their fields are compared and reported one by one.  Each field has a
+    // slot in DeltaState; a nested struct's fields follow its own slot.
+    template<typename T, typename JsonLibTraits>
+    struct Delta {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+
+        // Slots taken by T's fields.
+        static constexpr std::size_t slots() {
+            return slots(static_cast<const std::decay_t<decltype(T::config_fields())>*>(nullptr));
+        }
+
+        static bool apply(T& obj, const JsonValueType& j_val, DeltaState& state, std::size_t slot,
+                          std::vector<const char*>& path, ChangeSet& changes) {
+            if (!JsonLibTraits::is_object(j_val)) return fail(Errc::type_mismatch);
+            // Find every field's member in one pass, as fromJsonDispatch() does.
+            std::array<const JsonValueType*, field_count<T>> members{};
+            const auto& index = FieldIndex<T>::get();
+            JsonLibTraits::for_each_object_member(j_val, [&](std::string_view key, const JsonValueType& value) {
+                const std::size_t i = index.find(key);
+                if (i != FieldIndex<T>::npos) members[i] = &value;
+            });
+            return apply_fields(obj, members, state, slot, path, changes, std::make_index_sequence<field_count<T>>{});
+        }
+
+    private:
+        // Slots of the fields of a member of type M, beyond its own.
+        template<typename M>
+        static constexpr std::size_t nested_slots() {
+            if constexpr (has_config_fields<M>::value) return Delta<M, JsonLibTraits>::slots();
+            else return 0;
+        }
+
+        template<typename... Fields>
+        static constexpr std::size_t slots(const std::tuple<Fields...>*) {
+            return (std::size_t{0} + ... + (1 + nested_slots<std::decay_t<decltype(std::declval<T&>().*Fields::ptr_to_member)>>()));
+        }
+
+        template<std::size_t... Is>
+        static bool apply_fields(T& obj, const std::array<const JsonValueType*, field_count<T>>& members,
+                                 DeltaState& state, std::size_t slot, std::vector<const char*>& path,
+                                 ChangeSet& changes, std::index_sequence<Is...>) {
+            FirstError success;
+            ((success &= apply_field(std::get<Is>(field_table<T>()), obj, members[Is], state, slot, path, changes)), ...);
+            return success.result();
+        }
+
+        // The field names on path as a JSON pointer.  Built only for the
+        // fields which changed.
+        static std::string pointer(const std::vector<const char*>& path) {
+            std::string out;
+            for (const char* name : path) {
+                out += '/';
+                for (const char* c = name; *c; ++c) {
+                    if (*c == '~') out += "~0";
+                    else if (*c == '/') out += "~1";
+                    else out += *c;
+                }
+            }
+            return out;
+        }
+
+        // Convert the field at slot, advancing slot past it and its nested
+        // fields, if its JSON (member_json, or nullptr if absent) changed.
+        template<typename Field>
+        static bool apply_field(const Field& field, T& obj, const JsonValueType* member_json, DeltaState& state,
+                                std::size_t& slot, std::vector<const char*>& path, ChangeSet& changes) {
+            using MemberType = std::decay_t<decltype(obj.*field.ptr_to_member)>;
+            constexpr std::size_t nested = nested_slots<MemberType>();
+            const std::size_t own = slot;
+            slot += 1 + nested;
+
+            if constexpr (nested > 0) {
+                if (member_json && JsonLibTraits::is_object(*member_json)) {
+                    // Compared field by field, not as a whole.
+                    state.known[own] = false;
+                    path.push_back(field.name);
+                    const bool ok = Delta<MemberType, JsonLibTraits>::apply(obj.*field.ptr_to_member, *member_json,
+                                                                           state, own + 1, path, changes);
+                    path.pop_back();
+                    return ok || fail_in(field.name);
+                }
+            }
+
+            const std::uint64_t hash = member_json ? SubtreeHash<JsonLibTraits>::of(*member_json)
+                                                   : SubtreeHash<JsonLibTraits>::absent;
+            if (state.known[own] && state.hashes[own] == hash) return true;
+
+            // Replaced as a whole, so what was known of a struct's fields is stale.
+            std::fill(state.known.begin() + own + 1, state.known.begin() + own + 1 + nested, 0);
+            const bool ok = member_json ? field.template parse_value<JsonLibTraits>(obj, *member_json)
+                                        : field.use_default(obj);
+            state.hashes[own] = hash;
+            state.known[own] = ok;
+            path.push_back(field.name);
+            changes.paths.push_back(pointer(path));
+            path.pop_back();
+            return ok;
+        }
+    };
+
+    /// Reload obj from new_json, converting only the fields whose JSON
+    /// differs from what was applied last time according to state, and
+    /// report which those were.
+    ///
+    /// Every field's JSON is still hashed, which costs far less than
+    /// converting it and allocates nothing, but only changed fields are
+    /// converted.  The first call, with an empty state, converts and lists
+    /// every field, like fromJson().  Unknown members are ignored as
+    /// fromJson() ignores them.  If a field fails to convert, changes.ok is
+    /// false and that field is converted again on the next call.
+    template<typename JsonLibTraits, typename T>
+    ChangeSet diff_apply(T& obj, const typename JsonLibTraits::ValueType& new_json, DeltaState& state) {
+        static_assert(has_config_fields<T>::value, "diff_apply() needs a struct with config_fields()");
+        constexpr std::size_t slots = Delta<T, JsonLibTraits>::slots();
+        if (state.hashes.size() != slots) {
+            state.hashes.assign(slots, 0);
+            state.known.assign(slots, 0);
+        }
+        ChangeSet changes;
+        std::vector<const char*> path;
+        changes.ok = Delta<T, JsonLibTraits>::apply(obj, new_json, state, 0, path, changes);
+        return changes;
+    }
+}
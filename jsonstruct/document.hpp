@@ -0,0 +1,64 @@
+#pragma once
+
+#include <jsonstruct/load.hpp>
+#include <jsonstruct/stream.hpp>
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace jsonstruct {
+
+    /// JSON text together with everything std::string_view members decoded
+    /// from it may borrow.
+    ///
+    /// A string without escapes is decoded as a view straight into the
+    /// text, with no allocation.  One with escapes is unescaped into memory
+    /// owned by the Document.  Either way the views stay valid for as long
+    /// as the Document does.  The text is owned (a std::string or a
+    /// MappedFile) or borrowed; a Document can not be copied or moved, so
+    /// nothing it hands out is invalidated behind your back.
+    ///
+    /// (A DOM is already a document handle of this kind for the
+    /// Converter backends: std::string_view members borrow from the
+    /// strings held by the JSON value passed to fromJson().)
+    class Document {
+    public:
+        /// Own text.
+        explicit Document(std::string text)
+            : owned_(std::move(text)), text_(owned_) {}
+
+        /// Own a mapped file.
+        explicit Document(MappedFile file)
+            : file_(std::move(file)), text_(file_.view()) {}
+
+        /// Borrow text, which must outlive the Document.
+        static Document borrow(std::string_view text) { return Document(text); }
+
+        Document(const Document&) = delete;
+        Document& operator=(const Document&) = delete;
+
+        std::string_view text() const { return text_; }
+
+        /// Decode the whole text into obj with the stream backend.
+        template<typename T>
+        bool decode(T& obj) {
+            stream::Reader in(text_);
+            in.set_string_storage(&strings_);
+            return stream::Decoder<T>::decode(in, obj) && (in.at_end() || fail(Errc::syntax));
+        }
+
+        /// Free the unescaped strings.  Everything decoded so far which
+        /// borrowed one is left dangling.
+        void release() { strings_.release(); }
+
+    private:
+        explicit Document(std::string_view text) : text_(text) {}
+
+        std::string owned_;
+        MappedFile file_;
+        std::string_view text_;
+        std::pmr::monotonic_buffer_resource strings_;
+    };
+}
@@ -0,0 +1,255 @@
+#pragma once
+
+// Shortest-ish double to text using Grisu2 (Loitsch, "Printing
+// Floating-Point Numbers Quickly and Accurately with Integers", PLDI 2010)
+// with the boundary conventions and layout of nlohmann::json's dump(), so
+// that the stream writer reproduces its output byte for byte.  Grisu2 is
+// not always shortest, which is why std::to_chars() can not be used here.
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace jsonstruct::dtoa {
+
+    // f * 2^e
+    struct DiyFp {
+        std::uint64_t f;
+        int e;
+
+        static DiyFp sub(DiyFp x, DiyFp y) { return {x.f - y.f, x.e}; }
+
+        // Upper 64 bits of the 128-bit product, rounded half up.
+        static DiyFp mul(DiyFp x, DiyFp y) {
+            const std::uint64_t a = x.f >> 32, b = x.f & 0xFFFFFFFFu;
+            const std::uint64_t c = y.f >> 32, d = y.f & 0xFFFFFFFFu;
+            const std::uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+            std::uint64_t mid = (bd >> 32) + (ad & 0xFFFFFFFFu) + (bc & 0xFFFFFFFFu);
+            mid += std::uint64_t{1} << 31;
+            return {ac + (ad >> 32) + (bc >> 32) + (mid >> 32), x.e + y.e + 64};
+        }
+
+        static DiyFp normalize(DiyFp x) {
+            while ((x.f >> 63) == 0) { x.f <<= 1; --x.e; }
+            return x;
+        }
+    };
+
+    // Cached c = f * 2^e ~= 10^k for k = -300, -292, ..., 324.
+    struct CachedPower {
+        std::uint64_t f;
+        int e;
+        int k;
+    };
+
+    inline CachedPower cached_power(int e) {
+        static constexpr std::array<CachedPower, 79> powers{{
+                {0xAB70FE17C79AC6CA, -1060, -300},
+                {0xFF77B1FCBEBCDC4F, -1034, -292},
+                {0xBE5691EF416BD60C, -1007, -284},
+                {0x8DD01FAD907FFC3C,  -980, -276},
+                {0xD3515C2831559A83,  -954, -268},
+                {0x9D71AC8FADA6C9B5,  -927, -260},
+                {0xEA9C227723EE8BCB,  -901, -252},
+                {0xAECC49914078536D,  -874, -244},
+                {0x823C12795DB6CE57,  -847, -236},
+                {0xC21094364DFB5637,  -821, -228},
+                {0x9096EA6F3848984F,  -794, -220},
+                {0xD77485CB25823AC7,  -768, -212},
+                {0xA086CFCD97BF97F4,  -741, -204},
+                {0xEF340A98172AACE5,  -715, -196},
+                {0xB23867FB2A35B28E,  -688, -188},
+                {0x84C8D4DFD2C63F3B,  -661, -180},
+                {0xC5DD44271AD3CDBA,  -635, -172},
+                {0x936B9FCEBB25C996,  -608, -164},
+                {0xDBAC6C247D62A584,  -582, -156},
+                {0xA3AB66580D5FDAF6,  -555, -148},
+                {0xF3E2F893DEC3F126,  -529, -140},
+                {0xB5B5ADA8AAFF80B8,  -502, -132},
+                {0x87625F056C7C4A8B,  -475, -124},
+                {0xC9BCFF6034C13053,  -449, -116},
+                {0x964E858C91BA2655,  -422, -108},
+                {0xDFF9772470297EBD,  -396, -100},
+                {0xA6DFBD9FB8E5B88F,  -369,  -92},
+                {0xF8A95FCF88747D94,  -343,  -84},
+                {0xB94470938FA89BCF,  -316,  -76},
+                {0x8A08F0F8BF0F156B,  -289,  -68},
+                {0xCDB02555653131B6,  -263,  -60},
+                {0x993FE2C6D07B7FAC,  -236,  -52},
+                {0xE45C10C42A2B3B06,  -210,  -44},
+                {0xAA242499697392D3,  -183,  -36},
+                {0xFD87B5F28300CA0E,  -157,  -28},
+                {0xBCE5086492111AEB,  -130,  -20},
+                {0x8CBCCC096F5088CC,  -103,  -12},
+                {0xD1B71758E219652C,   -77,   -4},
+                {0x9C40000000000000,   -50,    4},
+                {0xE8D4A51000000000,   -24,   12},
+                {0xAD78EBC5AC620000,     3,   20},
+                {0x813F3978F8940984,    30,   28},
+                {0xC097CE7BC90715B3,    56,   36},
+                {0x8F7E32CE7BEA5C70,    83,   44},
+                {0xD5D238A4ABE98068,   109,   52},
+                {0x9F4F2726179A2245,   136,   60},
+                {0xED63A231D4C4FB27,   162,   68},
+                {0xB0DE65388CC8ADA8,   189,   76},
+                {0x83C7088E1AAB65DB,   216,   84},
+                {0xC45D1DF942711D9A,   242,   92},
+                {0x924D692CA61BE758,   269,  100},
+                {0xDA01EE641A708DEA,   295,  108},
+                {0xA26DA3999AEF774A,   322,  116},
+                {0xF209787BB47D6B85,   348,  124},
+                {0xB454E4A179DD1877,   375,  132},
+                {0x865B86925B9BC5C2,   402,  140},
+                {0xC83553C5C8965D3D,   428,  148},
+                {0x952AB45CFA97A0B3,   455,  156},
+                {0xDE469FBD99A05FE3,   481,  164},
+                {0xA59BC234DB398C25,   508,  172},
+                {0xF6C69A72A3989F5C,   534,  180},
+                {0xB7DCBF5354E9BECE,   561,  188},
+                {0x88FCF317F22241E2,   588,  196},
+                {0xCC20CE9BD35C78A5,   614,  204},
+                {0x98165AF37B2153DF,   641,  212},
+                {0xE2A0B5DC971F303A,   667,  220},
+                {0xA8D9D1535CE3B396,   694,  228},
+                {0xFB9B7CD9A4A7443C,   720,  236},
+                {0xBB764C4CA7A44410,   747,  244},
+                {0x8BAB8EEFB6409C1A,   774,  252},
+                {0xD01FEF10A657842C,   800,  260},
+                {0x9B10A4E5E9913129,   827,  268},
+                {0xE7109BFBA19C0C9D,   853,  276},
+                {0xAC2820D9623BF429,   880,  284},
+                {0x80444B5E7AA7CF85,   907,  292},
+                {0xBF21E44003ACDD2D,   933,  300},
+                {0x8E679C2F5E44FF8F,   960,  308},
+                {0xD433179D9C8CB841,   986,  316},
+                {0x9E19DB92B4E31BA9,  1013,  324},
+            }};
+        // Pick the power which brings the product's exponent into [-60, -32].
+        constexpr int alpha = -60;
+        const int f = alpha - e - 1;
+        const int k = (f * 78913) / (1 << 18) + static_cast<int>(f > 0);
+        return powers[static_cast<std::size_t>((300 + k + 7) / 8)];
+    }
+
+    inline void round_weed(char* buf, int len, std::uint64_t dist, std::uint64_t delta,
+                           std::uint64_t rest, std::uint64_t ten_k) {
+        while (rest < dist && delta - rest >= ten_k
+               && (rest + ten_k < dist || dist - rest > rest + ten_k - dist)) {
+            --buf[len - 1];
+            rest += ten_k;
+        }
+    }
+
+    // Digits of a value in [m_minus, m_plus], as close to w as Grisu2 gets.
+    inline void digit_gen(char* buf, int& len, int& exp10, DiyFp m_minus, DiyFp w, DiyFp m_plus) {
+        std::uint64_t delta = DiyFp::sub(m_plus, m_minus).f;
+        std::uint64_t dist = DiyFp::sub(m_plus, w).f;
+        const int shift = -m_plus.e;
+        const std::uint64_t one = std::uint64_t{1} << shift;
+        auto p1 = static_cast<std::uint32_t>(m_plus.f >> shift);
+        std::uint64_t p2 = m_plus.f & (one - 1);
+
+        std::uint32_t pow10 = 1;
+        int n = 1;
+        while (n < 10 && p1 >= pow10 * 10) { pow10 *= 10; ++n; }
+
+        for (; n > 0; --n, pow10 /= 10) {
+            buf[len++] = static_cast<char>('0' + p1 / pow10);
+            p1 %= pow10;
+            const std::uint64_t rest = (std::uint64_t{p1} << shift) + p2;
+            if (rest <= delta) {
+                exp10 += n - 1;
+                round_weed(buf, len, dist, delta, rest, std::uint64_t{pow10} << shift);
+                return;
+            }
+        }
+        int m = 0;
+        do {
+            p2 *= 10;
+            buf[len++] = static_cast<char>('0' + (p2 >> shift));
+            p2 &= one - 1;
+            ++m;
+            delta *= 10;
+            dist *= 10;
+        } while (p2 > delta);
+        exp10 -= m;
+        round_weed(buf, len, dist, delta, p2, one);
+    }
+
+    // Digits and decimal exponent of a finite, positive value.
+    inline void grisu2(char* buf, int& len, int& exp10, double value) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        constexpr std::uint64_t hidden = std::uint64_t{1} << 52;
+        constexpr int bias = 1075;
+        const std::uint64_t E = bits >> 52;
+        const std::uint64_t F = bits & (hidden - 1);
+        const DiyFp v = E == 0 ? DiyFp{F, 1 - bias} : DiyFp{F + hidden, static_cast<int>(E) - bias};
+
+        // Boundaries halfway to the neighbouring doubles.
+        const bool lower_closer = F == 0 && E > 1;
+        const DiyFp plus = DiyFp::normalize({2 * v.f + 1, v.e - 1});
+        DiyFp minus = lower_closer ? DiyFp{4 * v.f - 1, v.e - 2} : DiyFp{2 * v.f - 1, v.e - 1};
+        minus = {minus.f << (minus.e - plus.e), plus.e};
+        const DiyFp w = DiyFp::normalize(v);
+
+        const CachedPower cached = cached_power(plus.e);
+        const DiyFp c{cached.f, cached.e};
+        const DiyFp w_c = DiyFp::mul(w, c);
+        const DiyFp minus_c = DiyFp::mul(minus, c);
+        const DiyFp plus_c = DiyFp::mul(plus, c);
+        len = 0;
+        exp10 = -cached.k;
+        digit_gen(buf, len, exp10, {minus_c.f + 1, minus_c.e}, w_c, {plus_c.f - 1, plus_c.e});
+    }
+
+    /// Write a finite value as nlohmann::json does, returning the end.
+    /// The buffer must hold at least 32 characters.
+    inline char* format_nlohmann(char* first, double value) {
+        if (std::signbit(value)) { *first++ = '-'; value = -value; }
+        if (value == 0) {
+            std::memcpy(first, "0.0", 3);
+            return first + 3;
+        }
+        char* buf = first;
+        int k = 0, exp10 = 0;
+        grisu2(buf, k, exp10, value);
+        const int n = k + exp10;     // value is 0.DIGITS * 10^n
+        constexpr int min_exp = -4, max_exp = 15;
+
+        if (k <= n && n <= max_exp) {           // digits000.0
+            std::memset(buf + k, '0', static_cast<std::size_t>(n - k));
+            buf[n] = '.';
+            buf[n + 1] = '0';
+            return buf + n + 2;
+        }
+        if (0 < n && n <= max_exp) {            // dig.its
+            std::memmove(buf + n + 1, buf + n, static_cast<std::size_t>(k - n));
+            buf[n] = '.';
+            return buf + k + 1;
+        }
+        if (min_exp < n && n <= 0) {            // 0.000digits
+            std::memmove(buf + 2 - n, buf, static_cast<std::size_t>(k));
+            buf[0] = '0';
+            buf[1] = '.';
+            std::memset(buf + 2, '0', static_cast<std::size_t>(-n));
+            return buf + 2 - n + k;
+        }
+        if (k == 1) {                           // de+NN
+            buf += 1;
+        } else {                                // d.igitse+NN
+            std::memmove(buf + 2, buf + 1, static_cast<std::size_t>(k - 1));
+            buf[1] = '.';
+            buf += 1 + k;
+        }
+        *buf++ = 'e';
+        int e = n - 1;
+        *buf++ = e < 0 ? '-' : '+';
+        if (e < 0) e = -e;
+        if (e >= 100) *buf++ = static_cast<char>('0' + e / 100);
+        *buf++ = static_cast<char>('0' + e / 10 % 10);    // at least two digits
+        *buf++ = static_cast<char>('0' + e % 10);
+        return buf;
+    }
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <jsonstruct/error.hpp>
+#include <jsonstruct/hash.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace jsonstruct {
+
+    // An enum is converted by name when a constexpr function found by
+    // argument-dependent lookup, declared next to it, lists its names:
+    //
+    //     enum class Level { debug, info, warn };
+    //     constexpr auto json_enum_names(Level) {
+    //         return std::array{std::pair{Level::debug, "debug"},
+    //                           std::pair{Level::info, "info"},
+    //                           std::pair{Level::warn, "warn"}};
+    //     }
+    //
+    // A value is written as its name and read back through a hash table
+    // over the names built at compile time.  A value without a name is
+    // written as its underlying integer, which reads back as well.
+    //
+    // An enum of bit flags declares json_flag_names() instead, naming its
+    // bits.  A set of flags is written as an array of the names whose bits
+    // are all set, plus the bits no name covers as one integer element.
+
+    template<typename E, typename = void>
+    struct has_flag_names : std::false_type {};
+    template<typename E>
+    struct has_flag_names<E, std::void_t<decltype(json_flag_names(E{}))>> : std::is_enum<E> {};
+
+    template<typename E, typename = void>
+    struct has_enum_names : std::false_type {};
+    template<typename E>
+    struct has_enum_names<E, std::void_t<decltype(json_enum_names(E{}))>>
+        : std::bool_constant<std::is_enum_v<E> && !has_flag_names<E>::value> {};
+
+    template<typename E>
+    constexpr auto enum_entries() {
+        if constexpr (has_flag_names<E>::value) return json_flag_names(E{});
+        else return json_enum_names(E{});
+    }
+
+    // At least twice as many slots as names, so probes stay short.
+    constexpr std::size_t name_slots(std::size_t names) {
+        std::size_t size = 2;
+        while (size < 2 * names) size *= 2;
+        return size;
+    }
+
+    // Open addressing with linear probing; each slot holds the index
+    // of a name, or Entries' size if empty.
+    template<std::size_t Slots, typename Entries>
+    constexpr std::array<std::size_t, Slots> name_table(const Entries& entries) {
+        std::array<std::size_t, Slots> slots{};
+        for (std::size_t s = 0; s < Slots; ++s) slots[s] = entries.size();
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            std::size_t s = name_hash(entries[i].second) & (Slots - 1);
+            while (slots[s] != entries.size()) s = (s + 1) & (Slots - 1);
+            slots[s] = i;
+        }
+        return slots;
+    }
+
+    // Whether entry i names the value i, so a value's name is found by
+    // indexing rather than by a scan.
+    template<typename Entries>
+    constexpr bool dense_names(const Entries& entries) {
+        using U = std::underlying_type_t<typename Entries::value_type::first_type>;
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            if (static_cast<U>(entries[i].first) != static_cast<U>(i)) return false;
+        }
+        return true;
+    }
+
+    /// The names of enum E, from json_enum_names() or json_flag_names(),
+    /// with everything needed to look them up computed at compile time.
+    template<typename E>
+    struct EnumNames {
+        using underlying_type = std::underlying_type_t<E>;
+        static constexpr auto entries = enum_entries<E>();
+        static constexpr std::size_t size = entries.size();
+        static constexpr std::size_t npos = size;
+
+        /// Index in entries of the value called name, or npos.  The first
+        /// of several entries with one name wins.
+        static constexpr std::size_t find(std::string_view name) {
+            for (std::size_t s = name_hash(name) & (slots - 1); ; s = (s + 1) & (slots - 1)) {
+                const std::size_t i = table[s];
+                if (i == npos || std::string_view(entries[i].second) == name) return i;
+            }
+        }
+
+        /// The name of value, a string literal, or nullptr if it has none.
+        static constexpr const char* name(E value) {
+            if constexpr (dense_names(entries)) {
+                // A negative value wraps beyond size.
+                const auto i = static_cast<std::size_t>(static_cast<std::make_unsigned_t<underlying_type>>(value));
+                return i < size ? entries[i].second : nullptr;
+            } else {
+                for (const auto& entry : entries) {
+                    if (entry.first == value) return entry.second;
+                }
+                return nullptr;
+            }
+        }
+
+        /// Call func(name) for each named flag of value whose bits are all
+        /// set, in table order, and return the bits no name covers.
+        template<typename Func>
+        static underlying_type for_each_flag(E value, Func&& func) {
+            const auto bits = static_cast<underlying_type>(value);
+            underlying_type covered = 0;
+            for (const auto& entry : entries) {
+                const auto flag = static_cast<underlying_type>(entry.first);
+                if (flag != 0 && (bits & flag) == flag) {
+                    func(entry.second);
+                    covered |= flag;
+                }
+            }
+            return static_cast<underlying_type>(bits & ~covered);
+        }
+
+    private:
+        static constexpr std::size_t slots = name_slots(size);
+        static constexpr auto table = name_table<slots>(entries);
+    };
+
+    // The value called name, or fail with unknown_name.
+    template<typename E>
+    bool enum_from_name(std::string_view name, E& cpp_val) {
+        const std::size_t i = EnumNames<E>::find(name);
+        if (i == EnumNames<E>::npos) return fail(Errc::unknown_name);
+        cpp_val = EnumNames<E>::entries[i].first;
+        return true;
+    }
+
+    // Add the bits of the flag called name, or fail with unknown_name.
+    template<typename E>
+    bool add_flag(std::string_view name, std::underlying_type_t<E>& bits) {
+        const std::size_t i = EnumNames<E>::find(name);
+        if (i == EnumNames<E>::npos) return fail(Errc::unknown_name);
+        bits |= static_cast<std::underlying_type_t<E>>(EnumNames<E>::entries[i].first);
+        return true;
+    }
+}
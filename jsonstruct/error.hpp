@@ -0,0 +1,168 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace jsonstruct {
+
+    /// Why a decode failed.
+    enum class Errc : unsigned char {
+        none,
+        missing_required,   // a required field is absent
+        type_mismatch,      // a value of the wrong JSON kind or shape
+        variant_no_match,   // no alternative of a std::variant accepts the value
+        out_of_range,       // a number which the C++ type can not hold
+        unknown_name,       // a string which names no value of an enum
+        syntax,             // malformed input, for the backends which parse it
+        unreadable,         // the input file could not be opened
+        needs_storage,      // a std::string_view with escapes, and nowhere to unescape it
+    };
+
+    inline const char* to_string(Errc code) {
+        switch (code) {
+        case Errc::none: return "no error";
+        case Errc::missing_required: return "missing required field";
+        case Errc::type_mismatch: return "type mismatch";
+        case Errc::variant_no_match: return "no variant alternative matches";
+        case Errc::out_of_range: return "number out of range";
+        case Errc::unknown_name: return "unknown enum name";
+        case Errc::syntax: return "syntax error";
+        case Errc::unreadable: return "file could not be read";
+        case Errc::needs_storage: return "escaped string needs string storage";
+        }
+        return "unknown error";
+    }
+
+    /// Where and why a decode failed: an Errc and the JSON pointer (RFC
+    /// 6901) of the value at fault.
+    ///
+    /// Decoding which succeeds never touches it.  A failure records its code
+    /// where it happens, and each enclosing struct, container or map adds
+    /// its member name or index while returning false, so the path costs
+    /// nothing until something fails.  The storage is reused, so after the
+    /// first few failures on a thread recording one does not allocate.
+    class Error {
+    public:
+        Errc code() const { return code_; }
+        explicit operator bool() const { return code_ != Errc::none; }
+
+        /// JSON pointer to the value which failed, "" for the whole document.
+        std::string path() const {
+            std::string out;
+            out.reserve(trail_.size());
+            // The trail holds the segments innermost first.
+            std::size_t end = trail_.size();
+            while (end > 0) {
+                const std::size_t begin = trail_.rfind('/', end - 1);
+                out.append(trail_, begin, end - begin);
+                end = begin;
+            }
+            return out;
+        }
+
+        /// "path: reason", for logs.
+        std::string message() const {
+            std::string out = path();
+            out += out.empty() ? "" : ": ";
+            out += to_string(code_);
+            return out;
+        }
+
+        void clear() {
+            code_ = Errc::none;
+            trail_.clear();
+        }
+
+        // Used by the decoders, through fail() and fail_in().
+        void set(Errc code) {
+            code_ = code;
+            trail_.clear();
+        }
+        void enter(std::string_view segment) {
+            trail_ += '/';
+            for (char c : segment) {
+                if (c == '~') trail_ += "~0";
+                else if (c == '/') trail_ += "~1";
+                else trail_ += c;
+            }
+        }
+
+    private:
+        Errc code_{Errc::none};
+        std::string trail_;
+    };
+
+    // This thread's Error.
+    inline Error& error_context() {
+        thread_local Error error;
+        return error;
+    }
+
+    /// Where and why the last failed decode on this thread failed.  Only
+    /// meaningful right after a decode returned false.  Reporting it is up
+    /// to the caller: nothing is logged.
+    inline const Error& last_error() { return error_context(); }
+
+    // The error recorded before a trial which may fail without the decode
+    // failing, a variant alternative say, to be put back by restore() if
+    // the decode goes on.  Otherwise a struct which carries on past a
+    // failed field would report the trial's failure instead.  Copied only
+    // if there is one.
+    class ErrorMark {
+    public:
+        ErrorMark() {
+            if (error_context()) saved_ = error_context();
+        }
+        void restore() const {
+            if (saved_) error_context() = *saved_;
+            else error_context().clear();
+        }
+
+    private:
+        std::optional<Error> saved_;
+    };
+
+    // The results of several members of one value, for a decode which goes
+    // on past a failed member to convert the rest.  Each failure replaces
+    // the error of the one before, so the first is kept aside and put back
+    // by result(): the error then names the member at which a backend that
+    // stops at the first failure would have stopped.
+    class FirstError {
+    public:
+        FirstError& operator&=(bool ok) {
+            if (!ok && !first_) first_.emplace();
+            return *this;
+        }
+        bool result() const {
+            if (!first_) return true;
+            first_->restore();
+            return false;
+        }
+
+    private:
+        std::optional<ErrorMark> first_;
+    };
+
+    // Record a failure at the value being decoded.  Returns false, to be
+    // returned in turn.
+    inline bool fail(Errc code) {
+        error_context().set(code);
+        return false;
+    }
+
+    // A failure below the member called key, or element index, of the value
+    // being decoded, adding it to the path.  Returns false.
+    inline bool fail_in(std::string_view key) {
+        error_context().enter(key);
+        return false;
+    }
+
+    inline bool fail_in(std::size_t index) {
+        char buf[24];
+        const auto res = std::to_chars(buf, buf + sizeof buf, index);
+        return fail_in(std::string_view(buf, static_cast<std::size_t>(res.ptr - buf)));
+    }
+}
@@ -1,17 +1,37 @@
 #pragma once
 
-#include <jsonstruct/converter.hpp>
+#include <optional>   // C++17
+#include <type_traits>
 
-#include <iostream>             // debug for now
+#include <jsonstruct/error.hpp>
+#include <jsonstruct/instrument.hpp>
 
 namespace jsonstruct {
 
+    // Defined in converter.hpp, which should be included to use Field.
+    template<typename T, typename JsonLibTraits, typename Enable>
+    struct Converter;
+
+    // Tag for make_field(): the default is whatever the member holds in a
+    // default-constructed struct, i.e. its own default member initializer.
+    struct MemberDefault {};
+    inline constexpr MemberDefault member_default{};
+
+    // A default-constructed StructType, built once.
+    template<typename StructType>
+    const StructType& prototype() {
+        static const StructType proto{};
+        return proto;
+    }
+
     template<typename StructType, typename MemberType> // Removed JsonLibTraits from Field struct itself
     struct Field {
         const char* name;
         MemberType StructType::* ptr_to_member;
         std::optional<MemberType> default_value;
         bool is_required;
+        // For member_default, the struct whose member is the default.
+        const StructType* default_from{nullptr};
 
         Field(const char* n, MemberType StructType::* p)
             : name(n), ptr_to_member(p), is_required(true) {}
@@ -19,28 +39,62 @@ namespace jsonstruct {
         Field(const char* n, MemberType StructType::* p, const MemberType& default_val)
             : name(n), ptr_to_member(p), default_value(default_val), is_required(false) {}
 
+        Field(const char* n, MemberType StructType::* p, MemberDefault)
+            : name(n), ptr_to_member(p), is_required(false) {
+            static_assert(std::is_default_constructible_v<StructType>,
+                          "member_default takes the default from a default-constructed struct");
+            default_from = &prototype<StructType>();
+        }
+
         // Template parse and serialize methods on JsonLibTraits
         template<typename JsonLibTraits>
         bool parse(StructType& obj, const typename JsonLibTraits::ValueType& parent_json) const {
-            if (JsonLibTraits::has_member(parent_json, name)) {
-                // Use the generic Converter with the specified JsonLibTraits
-                return Converter<MemberType, JsonLibTraits, void>::fromJson(
-                    JsonLibTraits::get_member(parent_json, name), obj.*ptr_to_member);
+            // One lookup, no copy of the member's JSON subtree.
+            if (const auto* member_json = JsonLibTraits::find_member(parent_json, name)) {
+                return parse_value<JsonLibTraits>(obj, *member_json);
             } else {
-                if (default_value) {
-                    obj.*ptr_to_member = *default_value;
+                return use_default(obj);
+            }
+        }
+
+        // Convert the member's own JSON value, already found in the parent.
+        template<typename JsonLibTraits>
+        bool parse_value(StructType& obj, const typename JsonLibTraits::ValueType& member_json) const {
+            typename instrumentation_t<JsonLibTraits>::Scope scope(name, Phase::decode);
+            // Use the generic Converter with the specified JsonLibTraits
+            return Converter<MemberType, JsonLibTraits, void>::fromJson(member_json, obj.*ptr_to_member)
+                || fail_in(name);
+        }
+
+        // Handle the field being absent from the JSON: apply the default if
+        // there is one, fail with Errc::missing_required if the field is
+        // required.  Shared by all backends.
+        bool use_default(StructType& obj) const { return default_into(obj.*ptr_to_member); }
+
+        // As use_default(), into a value held outside a StructType (a
+        // column of them, say).
+        bool default_into(MemberType& member) const {
+            // Members which can not be copied (std::unique_ptr) have no default.
+            if constexpr (std::is_copy_assignable_v<MemberType>) {
+                if (default_from) {
+                    member = default_from->*ptr_to_member;
                     return true;
                 }
-                if (is_required) {
-                    std::cerr << "Error: Required field '" << name << "' missing in JSON." << std::endl;
-                    return false;
+                if (default_value) {
+                    member = *default_value;
+                    return true;
                 }
-                return true;
             }
+            if (is_required) {
+                fail(Errc::missing_required);
+                return fail_in(name);
+            }
+            return true;
         }
 
         template<typename JsonLibTraits>
         void serialize(const StructType& obj, typename JsonLibTraits::ValueType& parent_json) const {
+            typename instrumentation_t<JsonLibTraits>::Scope scope(name, Phase::encode);
             // Use the generic Converter with the specified JsonLibTraits
             JsonLibTraits::set_member(
                 parent_json, name,
@@ -58,4 +112,9 @@ namespace jsonstruct {
     Field<StructType, MemberType> make_field(const char* name, MemberType StructType::* ptr, const MemberType& default_val) {
         return Field<StructType, MemberType>(name, ptr, default_val);
     }
+
+    template<typename StructType, typename MemberType>
+    Field<StructType, MemberType> make_field(const char* name, MemberType StructType::* ptr, MemberDefault) {
+        return Field<StructType, MemberType>(name, ptr, member_default);
+    }
 }
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace jsonstruct {
+
+    // 64-bit FNV-1a of text, from the offset basis xor seed.  With no
+    // seed this is plain FNV-1a, which packed::fingerprint() writes into
+    // every stream header, so it must not change.
+    constexpr std::uint64_t fnv1a(std::string_view text, std::uint64_t seed = 0) {
+        std::uint64_t h = 14695981039346656037ull ^ seed;
+        for (char c : text) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    // FNV-1a with its high bits folded down, for tables indexed by the
+    // low bits of the hash of a name.
+    constexpr std::uint64_t name_hash(std::string_view name, std::uint64_t seed = 0) {
+        const std::uint64_t h = fnv1a(name, seed);
+        return h ^ (h >> 29);
+    }
+}
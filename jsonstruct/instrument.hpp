@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace jsonstruct {
+
+    // Instrumentation hooks called by the DOM converters and the stream
+    // writer.  A JsonLibTraits, or a stream writer Sink, selects them at
+    // compile time by declaring
+    //
+    //     using Instrumentation = SomeHooks;
+    //
+    // (see profile::Traits and profile::Sink in profile.hpp).  Those which
+    // do not get NoInstrumentation, whose hooks are empty and compile away.
+    //
+    // Hooks provide:
+    //
+    // - Scope(const char* name, Phase): constructed around the conversion
+    //   of one field (name is Field::name) or one element of a container
+    //   or map (name is any_element), destroyed when it is done.  The
+    //   stream writer tells an encode Scope produced(bytes), the length of
+    //   the text the value was written as, before it is destroyed.
+    //
+    // - variant_retry(): an untagged std::variant alternative which could
+    //   take the value's kind was tried and failed.
+    enum class Phase { decode, encode };
+
+    // The path segment for every element of an array or value of a map.
+    inline constexpr char any_element[] = "*";
+
+    struct NoInstrumentation {
+        struct Scope {
+            Scope(const char*, Phase) {}
+            void produced(std::size_t) {}
+        };
+        static void variant_retry() {}
+    };
+
+    template<typename JsonLibTraits, typename = void>
+    struct instrumentation { using type = NoInstrumentation; };
+
+    template<typename JsonLibTraits>
+    struct instrumentation<JsonLibTraits, std::void_t<typename JsonLibTraits::Instrumentation>> {
+        using type = typename JsonLibTraits::Instrumentation;
+    };
+
+    template<typename JsonLibTraits>
+    using instrumentation_t = typename instrumentation<JsonLibTraits>::type;
+}
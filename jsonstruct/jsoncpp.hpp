@@ -2,6 +2,14 @@
 
 #include <json/json.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+#include <jsonstruct/numeric.hpp>
 #include <jsonstruct/traits.hpp>
 
 namespace jsonstruct::jsoncpp {
@@ -18,12 +26,30 @@ namespace jsonstruct::jsoncpp {
         static bool is_bool(const ValueType& v) { return v.isBool(); }
         static bool is_double(const ValueType& v) { return v.isDouble(); }
         static bool is_null(const ValueType& v) { return v.isNull(); }
+        static bool is_integer(const ValueType& v) { return v.isIntegral(); }
+        static bool is_number(const ValueType& v) { return v.isNumeric(); }
 
         // Value retrieval
         static int get_int(const ValueType& v) { return v.asInt(); }
         static std::string get_string(const ValueType& v) { return v.asString(); }
+        static std::string_view get_string_view(const ValueType& v) {
+            const char* begin = nullptr;
+            const char* end = nullptr;
+            if (!v.getString(&begin, &end)) return {};
+            return std::string_view(begin, static_cast<std::size_t>(end - begin));
+        }
         static bool get_bool(const ValueType& v) { return v.asBool(); }
         static double get_double(const ValueType& v) { return v.asDouble(); }
+        static bool get_int64(const ValueType& v, std::int64_t& out) {
+            if (!v.isInt64()) return false;
+            out = v.asInt64();
+            return true;
+        }
+        static bool get_uint64(const ValueType& v, std::uint64_t& out) {
+            if (!v.isUInt64()) return false;
+            out = v.asUInt64();
+            return true;
+        }
 
         // Value creation
         static ValueType create_object() { return Json::Value(Json::objectValue); }
@@ -31,16 +57,72 @@ namespace jsonstruct::jsoncpp {
         static ValueType create_null() { return Json::Value(); } // JsonCpp default constructor makes null
         static ValueType create_int(int val) { return Json::Value(val); }
         static ValueType create_string(const std::string& val) { return Json::Value(val); }
+        static ValueType create_string(std::string_view val) { return Json::Value(val.data(), val.data() + val.size()); }
+        static ValueType create_static_string(const char* val) { return Json::Value(Json::StaticString(val)); }
         static ValueType create_bool(bool val) { return Json::Value(val); }
         static ValueType create_double(double val) { return Json::Value(val); }
+        static ValueType create_int64(std::int64_t val) { return Json::Value(static_cast<Json::Int64>(val)); }
+        // Signed when it fits, as the parser would read it: JsonCpp's
+        // operator== tells an int 1 from an unsigned 1.
+        static ValueType create_uint64(std::uint64_t val) {
+            if (fits<std::int64_t>(val)) return create_int64(static_cast<std::int64_t>(val));
+            return Json::Value(static_cast<Json::UInt64>(val));
+        }
+
+        static bool parse(const char* begin, const char* end, ValueType& out) {
+            Json::CharReaderBuilder builder;
+            const std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+            return reader->parse(begin, end, &out, nullptr);
+        }
 
         // Object operations
         static bool has_member(const ValueType& obj, const char* name) { return obj.isMember(name); }
-        static ValueType get_member(const ValueType& obj, const char* name) { return obj[name]; }
+        static const ValueType* find_member(const ValueType& obj, const char* name) {
+            return obj.find(name, name + std::strlen(name));
+        }
+        static const ValueType& get_member(const ValueType& obj, const char* name) { return *find_member(obj, name); }
         static void set_member(ValueType& obj, const char* name, const ValueType& val) { obj[name] = val; }
+        static void set_member(ValueType& obj, const char* name, ValueType&& val) { obj[name] = std::move(val); }
 
         // Array operations
+        static std::size_t array_size(const ValueType& arr) { return arr.size(); }
+        static void reserve_array(ValueType& arr, std::size_t n) {} // JsonCpp arrays are maps
         static void append_array_element(ValueType& arr, const ValueType& val) { arr.append(val); }
+        static void append_array_element(ValueType& arr, ValueType&& val) { arr.append(std::move(val)); }
+
+        template<typename Num>
+        static bool get_numbers(const ValueType& arr, Num* out) {
+            for (const auto& item : arr) {
+                if constexpr (std::is_same_v<Num, int>) {
+                    if (!item.isInt()) return false;
+                    *out++ = item.asInt();
+                } else if constexpr (std::is_integral_v<Num> && std::is_signed_v<Num>) {
+                    std::int64_t val;
+                    if (!get_int64(item, val) || !fits<Num>(val)) return false;
+                    *out++ = static_cast<Num>(val);
+                } else if constexpr (std::is_integral_v<Num>) {
+                    std::uint64_t val;
+                    if (!get_uint64(item, val) || !fits<Num>(val)) return false;
+                    *out++ = static_cast<Num>(val);
+                } else {
+                    if (!item.isDouble()) return false;
+                    const double val = item.asDouble();
+                    if (!fits<Num>(val)) return false;
+                    *out++ = static_cast<Num>(val);
+                }
+            }
+            return true;
+        }
+        template<typename Num>
+        static ValueType create_numbers(const Num* data, std::size_t n) {
+            ValueType arr(Json::arrayValue);
+            for (std::size_t i = 0; i < n; ++i) {
+                if constexpr (std::is_floating_point_v<Num>) arr.append(create_double(static_cast<double>(data[i])));
+                else if constexpr (std::is_signed_v<Num>) arr.append(create_int64(data[i]));
+                else arr.append(create_uint64(data[i]));
+            }
+            return arr;
+        }
 
         // JsonCpp array iteration is typically: for (const auto& item : arr) { ... }
         // JsonCpp object iteration: for (auto it = obj.begin(); it != obj.end(); ++it) { /* it.key(), *it */ }
@@ -50,9 +132,20 @@ namespace jsonstruct::jsoncpp {
         template<typename Callback> // Callback signature: void(const std::string& key, ValueType& value)
         static void for_each_object_member(ValueType& obj, Callback&& cb) {
             if (!obj.isObject()) return;
-            // JsonCpp's iterators require manual key access and dereference to value
-            for (auto key : obj.getMemberNames()) {
-                cb(key, obj[key]);
+            // Iterators rather than obj[key], which would look each key up
+            // again and can insert.
+            for (auto it = obj.begin(); it != obj.end(); ++it) {
+                cb(it.name(), *it);
+            }
+        }
+
+        template<typename Callback> // Callback signature: void(std::string_view key, const ValueType& value)
+        static void for_each_object_member(const ValueType& obj, Callback&& cb) {
+            if (!obj.isObject()) return;
+            for (auto it = obj.begin(); it != obj.end(); ++it) {
+                const char* end = nullptr;
+                const char* key = it.memberName(&end);
+                cb(std::string_view(key, static_cast<std::size_t>(end - key)), *it);
             }
         }
     };
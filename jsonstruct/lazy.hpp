@@ -0,0 +1,197 @@
+#pragma once
+
+#include <jsonstruct/converter.hpp>
+#include <jsonstruct/stream.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace jsonstruct {
+
+    // Where member lies within a T.
+    template<typename T, typename MemberType>
+    std::ptrdiff_t member_offset(MemberType T::* member) {
+        const T& proto = prototype<T>();
+        return reinterpret_cast<const char*>(&(proto.*member)) - reinterpret_cast<const char*>(&proto);
+    }
+
+    // Index in config_fields() of the field for member, or field_count<T>
+    // if it has none.  Members are told apart by their offset in a
+    // default-constructed T; the offsets are sorted once per type.
+    template<typename T, typename MemberType>
+    std::size_t field_index_of(MemberType T::* member) {
+        static const auto offsets = [] {
+            std::array<std::pair<std::ptrdiff_t, std::size_t>, field_count<T>> out{};
+            std::size_t i = 0;
+            std::apply([&](const auto&... field) {
+                ((out[i] = {member_offset(field.ptr_to_member), i}, ++i), ...);
+            }, field_table<T>());
+            std::sort(out.begin(), out.end());
+            return out;
+        }();
+        const std::ptrdiff_t offset = member_offset(member);
+        const auto it = std::lower_bound(offsets.begin(), offsets.end(), std::make_pair(offset, std::size_t{0}));
+        return it != offsets.end() && it->first == offset ? it->second : field_count<T>;
+    }
+
+    /// A view of T over a JSON object which converts each member the first
+    /// time it is asked for, and keeps it.
+    ///
+    /// Reading a few fields of a large document costs about as much as
+    /// converting just those: the rest are never touched.  Defaults and
+    /// required fields work as in fromJson(), field by field.  The JSON
+    /// value is referenced, not copied, so it must outlive the view.
+    template<typename T, typename JsonLibTraits>
+    class Lazy {
+    public:
+        using JsonValueType = typename JsonLibTraits::ValueType;
+
+        explicit Lazy(const JsonValueType& json) : json_(json) {}
+
+        /// False if the JSON is not an object, when every field fails.
+        bool valid() const { return JsonLibTraits::is_object(json_); }
+
+        /// The member, converted on first use.  nullptr if member is not
+        /// one of T's fields or failed to convert.
+        template<typename MemberType>
+        const MemberType* find(MemberType T::* member) {
+            const std::size_t i = field_index_of(member);
+            if (i == field_count<T>) return nullptr;
+            return load(i) ? &(value_.*member) : nullptr;
+        }
+
+        /// As find(), but a member which failed to convert is read as
+        /// whatever it holds in a default-constructed T (see ok()).
+        template<typename MemberType>
+        const MemberType& get(MemberType T::* member) {
+            find(member);
+            return value_.*member;
+        }
+
+        /// False if any field converted so far failed.
+        bool ok() const { return std::find(state_.begin(), state_.end(), failed) == state_.end(); }
+
+        /// Convert every field not yet converted and return the whole struct.
+        const T& value() {
+            for (std::size_t i = 0; i < field_count<T>; ++i) load(i);
+            return value_;
+        }
+
+    private:
+        enum State : unsigned char { pending, loaded, failed };
+
+        bool load(std::size_t i) {
+            if (state_[i] == pending) state_[i] = convert(i) ? loaded : failed;
+            return state_[i] == loaded;
+        }
+
+        bool convert(std::size_t i) {
+            if (!valid()) return fail(Errc::type_mismatch);
+            bool ok = false;
+            visit_field(field_table<T>(), i, [&](const auto& field) {
+                ok = field.template parse<JsonLibTraits>(value_, json_);
+            });
+            return ok;
+        }
+
+        const JsonValueType& json_;
+        T value_{};
+        std::array<State, field_count<T>> state_{};
+    };
+}
+
+namespace jsonstruct::stream {
+
+    /// As jsonstruct::Lazy, over JSON text.  The first access scans the
+    /// object once, skipping every value, to note where each field's
+    /// member starts; after that a member is decoded straight from its
+    /// place.  The text must outlive the view.
+    template<typename T>
+    class Lazy {
+    public:
+        explicit Lazy(std::string_view text) : text_(text) {}
+
+        /// False if the text is not a well-formed object, when every field
+        /// fails.
+        bool valid() {
+            index();
+            return indexed_ == indexed_ok;
+        }
+
+        template<typename MemberType>
+        const MemberType* find(MemberType T::* member) {
+            const std::size_t i = field_index_of(member);
+            if (i == field_count<T>) return nullptr;
+            return load(i) ? &(value_.*member) : nullptr;
+        }
+
+        template<typename MemberType>
+        const MemberType& get(MemberType T::* member) {
+            find(member);
+            return value_.*member;
+        }
+
+        bool ok() const { return std::find(state_.begin(), state_.end(), failed) == state_.end(); }
+
+        const T& value() {
+            for (std::size_t i = 0; i < field_count<T>; ++i) load(i);
+            return value_;
+        }
+
+    private:
+        enum State : unsigned char { pending, loaded, failed };
+        enum Indexed : unsigned char { not_indexed, indexed_ok, indexed_bad };
+        static constexpr std::size_t absent = static_cast<std::size_t>(-1);
+
+        // Where each field's value starts, the last occurrence winning as
+        // it would when decoding the whole object.
+        void index() {
+            if (indexed_ != not_indexed) return;
+            positions_.fill(absent);
+            Reader in(text_);
+            const auto& field_index = FieldIndex<T>::get();
+            bool good = in.object_begin();
+            std::string_view key;
+            while (good && in.next_key(key)) {
+                const std::size_t i = field_index.find(key);
+                if (i != FieldIndex<T>::npos) positions_[i] = in.position();
+                good = in.skip();
+            }
+            indexed_ = good && !in.failed() && in.at_end() ? indexed_ok : indexed_bad;
+            index_error_ = in.kind_at(0) == Reader::Kind::object ? Errc::syntax : Errc::type_mismatch;
+        }
+
+        bool load(std::size_t i) {
+            if (state_[i] == pending) state_[i] = convert(i) ? loaded : failed;
+            return state_[i] == loaded;
+        }
+
+        bool convert(std::size_t i) {
+            if (!valid()) return fail(index_error_);
+            bool ok = false;
+            visit_field(field_table<T>(), i, [&](const auto& field) {
+                using MemberType = std::decay_t<decltype(value_.*field.ptr_to_member)>;
+                if (positions_[i] == absent) {
+                    ok = field.use_default(value_);
+                } else {
+                    Reader in(text_);
+                    in.seek(positions_[i]);
+                    ok = Decoder<MemberType>::decode(in, value_.*field.ptr_to_member) || fail_in(field.name);
+                }
+            });
+            return ok;
+        }
+
+        std::string_view text_;
+        T value_{};
+        std::array<State, field_count<T>> state_{};
+        std::array<std::size_t, field_count<T>> positions_{};
+        Indexed indexed_{not_indexed};
+        Errc index_error_{Errc::none};
+    };
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <jsonstruct/batch.hpp>
+#include <jsonstruct/stream.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JSONSTRUCT_HAVE_MMAP 1
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace jsonstruct {
+
+    /// A whole file mapped read-only into memory.
+    ///
+    /// Decoding straight from the mapping means the file is never copied
+    /// into a stream buffer or a std::string first.  std::string_view
+    /// members decoded by the stream backend point into the mapping, so
+    /// keep the MappedFile alive for as long as they are used.  Where mmap
+    /// is not available the file is read into memory instead.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::string& path) { open(path); }
+        ~MappedFile() { close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept { swap(other); }
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                close();
+                swap(other);
+            }
+            return *this;
+        }
+
+        /// Map the file at path, replacing any earlier mapping.
+        bool open(const std::string& path) {
+            close();
+#ifdef JSONSTRUCT_HAVE_MMAP
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) return false;
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                return false;
+            }
+            size_ = static_cast<std::size_t>(st.st_size);
+            if (size_ > 0) {
+                void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (addr == MAP_FAILED) {
+                    ::close(fd);
+                    size_ = 0;
+                    return false;
+                }
+                ::madvise(addr, size_, MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(addr);
+            }
+            ::close(fd);
+            open_ = true;
+#else
+            std::ifstream ifs(path, std::ios::binary);
+            if (!ifs) return false;
+            buffer_.assign(std::istreambuf_iterator<char>(ifs), {});
+            data_ = buffer_.data();
+            size_ = buffer_.size();
+            open_ = true;
+#endif
+            return true;
+        }
+
+        void close() {
+#ifdef JSONSTRUCT_HAVE_MMAP
+            if (data_) ::munmap(const_cast<char*>(data_), size_);
+#else
+            buffer_.clear();
+#endif
+            data_ = nullptr;
+            size_ = 0;
+            open_ = false;
+        }
+
+        bool is_open() const { return open_; }
+        const char* data() const { return data_; }
+        std::size_t size() const { return size_; }
+        std::string_view view() const { return std::string_view(data_, size_); }
+
+    private:
+        void swap(MappedFile& other) noexcept {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(open_, other.open_);
+#ifndef JSONSTRUCT_HAVE_MMAP
+            std::swap(buffer_, other.buffer_);
+#endif
+        }
+
+        const char* data_{nullptr};
+        std::size_t size_{0};
+        bool open_{false};
+#ifndef JSONSTRUCT_HAVE_MMAP
+        std::string buffer_;
+#endif
+    };
+
+    /// Decode the JSON file at path into obj with the stream backend, which
+    /// reads the mapped bytes directly and builds no DOM.  obj must not
+    /// borrow from the text (std::string_view members), which is checked at
+    /// compile time: the file is unmapped on return.  Map it yourself with
+    /// MappedFile for that.
+    template<typename T>
+    bool load(const std::string& path, T& obj) {
+        static_assert(!borrows_text<T>(), "obj would borrow from a file unmapped on return; map it with MappedFile");
+        const MappedFile file(path);
+        if (!file.is_open()) return fail(Errc::unreadable);
+        return stream::from_json(file.view(), obj);
+    }
+
+    /// Likewise through a DOM backend, which parses the mapped bytes in
+    /// place with JsonLibTraits::parse() and then converts.  The DOM goes
+    /// on return too.
+    template<typename T, typename JsonLibTraits>
+    bool load(const std::string& path, T& obj) {
+        static_assert(!borrows_text<T>(), "obj would borrow from a DOM freed on return; convert one you keep");
+        const MappedFile file(path);
+        if (!file.is_open()) return fail(Errc::unreadable);
+        typename JsonLibTraits::ValueType doc;
+        if (!JsonLibTraits::parse(file.data(), file.data() + file.size(), doc)) return fail(Errc::syntax);
+        return Converter<T, JsonLibTraits>::fromJson(doc, obj);
+    }
+
+    /// Decode the records of a mapped file: the elements of a top-level
+    /// array if the file is one (and T is not itself an array), otherwise
+    /// the lines of NDJSON.  The records may borrow from file.
+    template<typename T>
+    stream::BatchResult<T> load_batch(const MappedFile& file, const stream::BatchOptions& options = {}) {
+        const std::string_view text = file.view();
+        const std::size_t first = text.find_first_not_of(" \t\r\n");
+        if (first != std::string_view::npos && text[first] == '[' && !(json_kinds<T>::value & kind_array)) {
+            return stream::decode_array<T>(text, options);
+        }
+        return stream::decode_ndjson<T>(text, options);
+    }
+
+    /// As above for the file at path, which is unmapped on return.  If it
+    /// can not be mapped there are no records and one error, at index 0.
+    /// The records must not borrow from the text (std::string_view
+    /// members); load_batch() a MappedFile you keep for that.
+    template<typename T>
+    stream::BatchResult<T> load_batch(const std::string& path, const stream::BatchOptions& options = {}) {
+        static_assert(!borrows_text<T>(),
+                      "the records would borrow from a file unmapped on return; load_batch() a MappedFile instead");
+        const MappedFile file(path);
+        if (!file.is_open()) {
+            stream::BatchResult<T> result;
+            result.errors.push_back({0, 0, 0, Errc::unreadable, std::string()});
+            return result;
+        }
+        return load_batch<T>(file, options);
+    }
+}
@@ -2,6 +2,12 @@
 
 #include <nlohmann/json.hpp> 
 
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include <jsonstruct/numeric.hpp>
 #include <jsonstruct/traits.hpp>
 
 namespace jsonstruct::nlohmannjson {
@@ -18,12 +24,26 @@ namespace jsonstruct::nlohmannjson {
         static bool is_bool(const ValueType& v) { return v.is_boolean(); }
         static bool is_double(const ValueType& v) { return v.is_number_float(); } // Nlohmann distinguishes int/float numbers
         static bool is_null(const ValueType& v) { return v.is_null(); }
+        static bool is_integer(const ValueType& v) { return v.is_number_integer(); }
+        static bool is_number(const ValueType& v) { return v.is_number(); }
 
         // Value retrieval
         static int get_int(const ValueType& v) { return v.get<int>(); }
         static std::string get_string(const ValueType& v) { return v.get<std::string>(); }
+        static std::string_view get_string_view(const ValueType& v) { return v.get_ref<const ValueType::string_t&>(); }
         static bool get_bool(const ValueType& v) { return v.get<bool>(); }
         static double get_double(const ValueType& v) { return v.get<double>(); }
+        // Non-negative integers are parsed as unsigned, the rest as signed.
+        static bool get_int64(const ValueType& v, std::int64_t& out) {
+            if (const auto* i = v.get_ptr<const ValueType::number_integer_t*>()) { out = *i; return true; }
+            if (const auto* u = v.get_ptr<const ValueType::number_unsigned_t*>()) return narrow_to(*u, out);
+            return false;
+        }
+        static bool get_uint64(const ValueType& v, std::uint64_t& out) {
+            if (const auto* u = v.get_ptr<const ValueType::number_unsigned_t*>()) { out = *u; return true; }
+            if (const auto* i = v.get_ptr<const ValueType::number_integer_t*>()) return narrow_to(*i, out);
+            return false;
+        }
 
         // Value creation
         static ValueType create_object() { return ValueType::object(); }
@@ -31,18 +51,74 @@ namespace jsonstruct::nlohmannjson {
         static ValueType create_null() { return ValueType(); } // Default constructed nlohmann::json is null
         static ValueType create_int(int val) { return ValueType(val); }
         static ValueType create_string(const std::string& val) { return ValueType(val); }
+        static ValueType create_string(std::string_view val) { return ValueType(ValueType::string_t(val)); }
+        static ValueType create_static_string(const char* val) { return ValueType(val); } // always copied
         static ValueType create_bool(bool val) { return ValueType(val); }
         static ValueType create_double(double val) { return ValueType(val); }
+        static ValueType create_int64(std::int64_t val) { return ValueType(static_cast<ValueType::number_integer_t>(val)); }
+        static ValueType create_uint64(std::uint64_t val) { return ValueType(static_cast<ValueType::number_unsigned_t>(val)); }
+
+        static bool parse(const char* begin, const char* end, ValueType& out) {
+            out = ValueType::parse(begin, end, nullptr, false);
+            return !out.is_discarded();
+        }
 
         // Object operations
         static bool has_member(const ValueType& obj, const char* name) { return obj.contains(name); }
+        static const ValueType* find_member(const ValueType& obj, const char* name) {
+            auto it = obj.find(name);
+            return it == obj.end() ? nullptr : &*it;
+        }
         // nlohmann::json::at(key) returns a reference (json& or const json&).
-        // Returning ValueType is safe and consistent with jsonstruct::Traits.
-        static ValueType get_member(const ValueType& obj, const char* name) { return obj.at(name); }
+        static const ValueType& get_member(const ValueType& obj, const char* name) { return obj.at(name); }
         static void set_member(ValueType& obj, const char* name, const ValueType& val) { obj[name] = val; }
+        static void set_member(ValueType& obj, const char* name, ValueType&& val) { obj[name] = std::move(val); }
 
         // Array operations
+        static std::size_t array_size(const ValueType& arr) { return arr.size(); }
+        static void reserve_array(ValueType& arr, std::size_t n) { arr.get_ref<ValueType::array_t&>().reserve(n); }
         static void append_array_element(ValueType& arr, const ValueType& val) { arr.push_back(val); }
+        static void append_array_element(ValueType& arr, ValueType&& val) { arr.push_back(std::move(val)); }
+
+        // Works on the underlying std::vector, reading each number
+        // straight from its node.
+        template<typename Num>
+        static bool get_numbers(const ValueType& arr, Num* out) {
+            const auto& items = arr.get_ref<const ValueType::array_t&>();
+            for (const auto& item : items) {
+                if constexpr (std::is_integral_v<Num>) {
+                    if (const auto* u = item.get_ptr<const ValueType::number_unsigned_t*>()) {
+                        if (!narrow_to(*u, *out++)) return false;
+                    } else if (const auto* i = item.get_ptr<const ValueType::number_integer_t*>()) {
+                        if (!narrow_to(*i, *out++)) return false;
+                    } else {
+                        return false;
+                    }
+                } else {
+                    if (const auto* f = item.get_ptr<const ValueType::number_float_t*>()) {
+                        if (!narrow_to(*f, *out++)) return false;
+                    } else if (item.is_number()) {
+                        *out++ = static_cast<Num>(item.get<double>());
+                    } else {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+        template<typename Num>
+        static ValueType create_numbers(const Num* data, std::size_t n) {
+            ValueType::array_t items(data, data + n);
+            return ValueType(std::move(items));
+        }
+
+        // As jsonstruct::narrow(), without recording an error.
+        template<typename Num, typename From>
+        static bool narrow_to(From val, Num& out) {
+            if (!fits<Num>(val)) return false;
+            out = static_cast<Num>(val);
+            return true;
+        }
 
         // --- Nlohmann/json-specific Object Iteration ---
         template<typename Callback> // Callback signature: void(const std::string& key, ValueType& value)
@@ -53,6 +129,14 @@ namespace jsonstruct::nlohmannjson {
                 cb(it.key(), it.value());
             }
         }
+
+        template<typename Callback> // Callback signature: void(std::string_view key, const ValueType& value)
+        static void for_each_object_member(const ValueType& obj, Callback&& cb) {
+            if (!obj.is_object()) return;
+            for (auto it = obj.cbegin(); it != obj.cend(); ++it) {
+                cb(std::string_view(it.key()), it.value());
+            }
+        }
     };
 
 }
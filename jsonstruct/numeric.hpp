@@ -0,0 +1,48 @@
+#pragma once
+
+#include <jsonstruct/error.hpp>
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace jsonstruct {
+
+    // The C++ number types: every integral and floating point type but
+    // bool, which is a JSON kind of its own.
+    template<typename T>
+    struct is_number_type : std::bool_constant<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>> {};
+
+    // Whether val can be held by Num.  An integer must be within Num's
+    // range exactly.  A floating point value must not be beyond Num's
+    // largest finite value; rounding to a narrower type is not an error,
+    // and neither are infinity and NaN, which every floating type holds.
+    template<typename Num, typename From>
+    constexpr bool fits(From val) {
+        using Limits = std::numeric_limits<Num>;
+        if constexpr (std::is_floating_point_v<Num>) {
+            if constexpr (!std::is_floating_point_v<From> || sizeof(Num) >= sizeof(From)) {
+                return true;
+            } else {
+                return !(std::fabs(val) > Limits::max()) || std::isinf(val);
+            }
+        } else {
+            static_assert(std::is_integral_v<From>, "an integer is only narrowed from an integer");
+            if constexpr (std::is_signed_v<From> == std::is_signed_v<Num>) {
+                return val >= Limits::min() && val <= Limits::max();
+            } else if constexpr (std::is_signed_v<From>) {
+                return val >= 0 && static_cast<std::make_unsigned_t<From>>(val) <= Limits::max();
+            } else {
+                return val <= static_cast<std::make_unsigned_t<Num>>(Limits::max());
+            }
+        }
+    }
+
+    // Store val as a Num, or fail with out_of_range if it does not fit.
+    template<typename Num, typename From>
+    bool narrow(From val, Num& out) {
+        if (!fits<Num>(val)) return fail(Errc::out_of_range);
+        out = static_cast<Num>(val);
+        return true;
+    }
+}
@@ -0,0 +1,574 @@
+#pragma once
+
+#include <jsonstruct/converter.hpp>
+#include <jsonstruct/hash.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace jsonstruct::packed {
+
+    /// A schema-compiled binary layout for streams of records of one type.
+    ///
+    /// A stream starts with a header holding a fingerprint of the record
+    /// type's schema: every field name and member type from config_fields(),
+    /// recursively.  After that each record is its values alone, in field
+    /// order, with no keys, counts or type bytes for what the schema already
+    /// says.  Numbers are fixed-width little-endian, lengths are LEB128, and
+    /// an optional or variant is a byte (presence or index) then its value.
+    /// Decoding checks the fingerprint once and then runs straight through
+    /// each record with no key lookups.  Every field is always written, so
+    /// defaults and required fields do not come into it.
+
+    /// Bytes consumed by a record decode.
+    class Input {
+    public:
+        Input(const std::uint8_t* data, std::size_t size) : data_(data), size_(size) {}
+
+        bool failed() const { return failed_; }
+        std::size_t position() const { return pos_; }
+        bool at_end() const { return pos_ == size_; }
+
+        /// Mark the input malformed, for a byte which is read but is not
+        /// one the layout allows.  Returns false.
+        bool fail() { failed_ = true; return false; }
+
+        /// The next n bytes, or nullptr (and failed) if there are fewer.
+        const std::uint8_t* take(std::size_t n) {
+            if (n > size_ - pos_) { failed_ = true; return nullptr; }
+            const std::uint8_t* p = data_ + pos_;
+            pos_ += n;
+            return p;
+        }
+
+        bool varint(std::uint64_t& val) {
+            val = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                const std::uint8_t* b = take(1);
+                if (!b) return false;
+                val |= static_cast<std::uint64_t>(*b & 0x7f) << shift;
+                if (!(*b & 0x80)) return true;
+            }
+            failed_ = true;
+            return false;
+        }
+
+        /// A length or count, which can not exceed the bytes left since
+        /// every element takes at least one.
+        bool length(std::size_t& n) {
+            std::uint64_t val;
+            if (!varint(val) || val > size_ - pos_) { failed_ = true; return false; }
+            n = static_cast<std::size_t>(val);
+            return true;
+        }
+
+        template<typename Num>
+        bool fixed(Num& val) {
+            const std::uint8_t* p = take(sizeof(Num));
+            if (!p) return false;
+            val = load<Num>(p);
+            return true;
+        }
+
+        template<typename Num>
+        static Num load(const std::uint8_t* p) {
+            Num val;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            std::memcpy(&val, p, sizeof(Num));
+#else
+            std::array<std::uint8_t, sizeof(Num)> bytes;
+            for (std::size_t i = 0; i < sizeof(Num); ++i) bytes[i] = p[sizeof(Num) - 1 - i];
+            std::memcpy(&val, bytes.data(), sizeof(Num));
+#endif
+            return val;
+        }
+
+    private:
+        const std::uint8_t* data_;
+        std::size_t size_;
+        std::size_t pos_{0};
+        bool failed_{false};
+    };
+
+    /// Bytes produced by a record encode, appended to a Sink with
+    /// push_back(std::uint8_t) and insert(end(), first, last).
+    template<typename Sink>
+    class Output {
+    public:
+        explicit Output(Sink& sink) : sink_(sink) {}
+
+        void byte(std::uint8_t b) { sink_.push_back(b); }
+
+        void bytes(const void* data, std::size_t n) {
+            const auto* p = static_cast<const std::uint8_t*>(data);
+            sink_.insert(sink_.end(), p, p + n);
+        }
+
+        void varint(std::uint64_t val) {
+            std::array<std::uint8_t, 10> buf;
+            std::size_t n = 0;
+            do {
+                buf[n++] = static_cast<std::uint8_t>((val & 0x7f) | (val > 0x7f ? 0x80 : 0));
+                val >>= 7;
+            } while (val);
+            bytes(buf.data(), n);
+        }
+
+        template<typename Num>
+        void fixed(Num val) {
+            std::array<std::uint8_t, sizeof(Num)> buf;
+            std::memcpy(buf.data(), &val, sizeof(Num));
+#if !(defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+            std::reverse(buf.begin(), buf.end());
+#endif
+            bytes(buf.data(), buf.size());
+        }
+
+    private:
+        Sink& sink_;
+    };
+
+    // Types being described, innermost last, so that a recursive struct
+    // refers back to itself instead of describing itself forever.
+    using Describing = std::vector<const void*>;
+
+    /// How one C++ type is laid out.  Each specialization can describe()
+    /// its schema, encode() and decode().
+    template<typename T, typename Enable = void>
+    struct Layout;
+
+    // Numbers: fixed width, little-endian, each named for its kind and
+    // bits ("i32", "u8", "f64").  A long double is written as a double.
+    template<typename Num>
+    struct Layout<Num, std::enable_if_t<is_number_type<Num>::value>> {
+        using wire_type = std::conditional_t<std::is_same_v<Num, long double>, double, Num>;
+
+        static void describe(std::string& out, Describing&) {
+            out += std::is_floating_point_v<Num> ? 'f' : std::is_signed_v<Num> ? 'i' : 'u';
+            out += std::to_string(8 * sizeof(wire_type));
+        }
+        template<typename Sink>
+        static void encode(Output<Sink>& out, const Num& cpp_val) { out.fixed(static_cast<wire_type>(cpp_val)); }
+        static bool decode(Input& in, Num& cpp_val) {
+            wire_type val;
+            if (!in.fixed(val)) return false;
+            cpp_val = static_cast<Num>(val);
+            return true;
+        }
+    };
+
+    // Enums and flag sets: their underlying integer.
+    template<typename E>
+    struct Layout<E, std::enable_if_t<has_enum_names<E>::value || has_flag_names<E>::value>> {
+        using Underlying = std::underlying_type_t<E>;
+        static void describe(std::string& out, Describing& open) { Layout<Underlying>::describe(out, open); }
+        template<typename Sink>
+        static void encode(Output<Sink>& out, const E& cpp_val) {
+            Layout<Underlying>::encode(out, static_cast<Underlying>(cpp_val));
+        }
+        static bool decode(Input& in, E& cpp_val) {
+            Underlying bits{};
+            if (!Layout<Underlying>::decode(in, bits)) return false;
+            cpp_val = static_cast<E>(bits);
+            return true;
+        }
+    };
+
+    template<>
+    struct Layout<bool, void> {
+        static void describe(std::string& out, Describing&) { out += "b"; }
+        template<typename Sink>
+        static void encode(Output<Sink>& out, const bool& cpp_val) { out.byte(cpp_val ? 1 : 0); }
+        static bool decode(Input& in, bool& cpp_val) {
+            const std::uint8_t* b = in.take(1);
+            if (!b) return false;
+            if (*b > 1) return in.fail();
+            cpp_val = *b == 1;
+            return true;
+        }
+    };
+
+    // Strings: length then bytes.  A std::string_view borrows from the input.
+    template<>
+    struct Layout<std::string_view, void> {
+        static void describe(std::string& out, Describing&) { out += "s"; }
+        template<typename Sink>
+        static void encode(Output<Sink>& out, const std::string_view& cpp_val) {
+            out.varint(cpp_val.size());
+            out.bytes(cpp_val.data(), cpp_val.size());
+        }
+        static bool decode(Input& in, std::string_view& cpp_val) {
+            std::size_t n;
+            if (!in.length(n)) return false;
+            cpp_val = std::string_view(reinterpret_cast<const char*>(in.take(n)), n);
+            return true;
+        }
+    };
+
+    template<typename Alloc>
+    struct Layout<std::basic_string<char, std::char_traits<char>, Alloc>, void> {
+        using String = std::basic_string<char, std::char_traits<char>, Alloc>;
+        static void describe(std::string& out, Describing&) { out += "s"; }
+        template<typename Sink>
+        static void encode(Output<Sink>& out, const String& cpp_val) {
+            Layout<std::string_view>::encode(out, cpp_val);
+        }
+        static bool decode(Input& in, String& cpp_val) {
+            std::string_view view;
+            if (!Layout<std::string_view>::decode(in, view)) return false;
+            cpp_val.assign(view.data(), view.size());
+            return true;
+        }
+    };
+
+    // Shared by vector and deque: count then elements.  A std::vector of
+    // numbers is copied as one block.
+    template<typename Container>
+    struct SequenceLayout {
+        using T_elem = typename Container::value_type;
+        static void describe(std::string& out, Describing& open) {
+            out += '[';
+            Layout<T_elem>::describe(out, open);
+            out += ']';
+        }
+        template<typename Sink>
+        static void encode(Output<Sink>& out, const Container& cpp_val) {
+            out.varint(cpp_val.size());
+            if constexpr (block_copy) {
+                out.bytes(cpp_val.data(), cpp_val.size() * sizeof(T_elem));
+            } else {
+                for (const auto& elem : cpp_val) Layout<T_elem>::encode(out, elem);
+            }
+        }
+        static bool decode(Input& in, Container& cpp_val) {
+            std::size_t n;
+            if (!in.length(n)) return false;
+            if constexpr (block_copy) {
+                const std::uint8_t* p = in.take(n * sizeof(T_elem));
+                if (!p) return false;
+                cpp_val.resize(n);
+                std::memcpy(cpp_val.data(), p, n * sizeof(T_elem));
+                return true;
+            } else {
+                cpp_val.clear();
+                if constexpr (std::is_same_v<Container, std::vector<T_elem, typename Container::allocator_type>>) {
+                    cpp_val.reserve(n);
+                }
+                for (std::size_t i = 0; i < n; ++i) {
+                    if constexpr (std::is_same_v<T_elem, bool>) {
+                        bool elem;
+                        if (!Layout<bool>::decode(in, elem)) return false;
+                        cpp_val.push_back(elem);
+                    } else {
+                        cpp_val.emplace_back();
+                        if (!Layout<T_elem>::decode(in, cpp_val.back())) return false;
+                    }
+                }
+                return true;
+            }
+        }
+
+    private:
+        // The memory of a number already is the wire format, but for long
+        // double.
+        static constexpr bool block_copy =
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            is_bulk_number<T_elem>::value && has_data<Container>::value && !std::is_same_v<T_elem, long double>;
+#else
+            false;
+#endif
+    };
+
+    template<typename T_elem, typename Alloc>
+    struct Layout<std::vector<T_elem, Alloc>, void> : SequenceLayout<std::vector<T_elem, Alloc>> {};
+
+    template<typename T_elem, typename Alloc>
+    struct Layout<std::deque<T_elem, Alloc>, void> : SequenceLayout<std::deque<T_elem, Alloc>> {};
+
+    // Fixed size, so no count.
+    template<typename T_elem, std::size_t N>
+    struct Layout<std::array<T_elem, N>, void> {
+        static void describe(std::string& out, Describing& open) {
+            out += '[';
+            Layout<T_elem>::describe(out, open);
+            out += ';';
+            out += std::to_string(N);
+            out += ']';
+        }
+        template<typename Sink>
+        static void encode(Output<Sink>& out, const std::array<T_elem, N>& cpp_val) {
+            for (const auto& elem : cpp_val) Layout<T_elem>::encode(out, elem);
+        }
+        static bool decode(Input& in, std::array<T_elem, N>& cpp_val) {
+            for (auto& elem : cpp_val) {
+                if (!Layout<T_elem>::decode(in, elem)) return false;
+            }
+            return true;
+        }
+    };
+
+    // Shared by the string-keyed maps: count then key, value pairs.
+    template<typename Map>
+    struct MapLayout {
+        static void describe(std::string& out, Describing& open) {
+            out += "{s:";
+            Layout<typename Map::mapped_type>::describe(out, open);
+            out += '}';
+        }
+        template<typename Sink>
+        static void encode(Output<Sink>& out, const Map& cpp_val) {
+            out.varint(cpp_val.size());
+            for (const auto& [key, val] : cpp_val) {
+                Layout<std::string_view>::encode(out, key);
+                Layout<typename Map::mapped_type>::encode(out, val);
+            }
+        }
+        static bool decode(Input& in, Map& cpp_val) {
+            std::size_t n;
+            if (!in.length(n)) return false;
+            cpp_val.clear();
+            using Key = typename Map::key_type;
+            for (std::size_t i = 0; i < n; ++i) {
+                std::string_view key;
+                if (!Layout<std::string_view>::decode(in, key)) return false;
+                auto it = cpp_val.try_emplace(Key(key, typename Key::allocator_type(cpp_val.get_allocator()))).first;
+                if (!Layout<typename Map::mapped_type>::decode(in, it->second)) return false;
+            }
+            return true;
+        }
+    };
+
+    template<typename KeyAlloc, typename T_val, typename Compare, typename Alloc>
+    struct Layout<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>, void>
+        : MapLayout<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>> {};
+
+    template<typename KeyAlloc, typename T_val, typename Hash, typename Equal, typename Alloc>
+    struct Layout<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>, void>
+        : MapLayout<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>> {};
+
+    // Shared by optional and the smart pointers: a presence byte, then the
+    // value if present.
+    template<typename Holder, typename T_val>
+    struct NullableLayout {
+        static void describe(std::string& out, Describing& open) {
+            out += '?';
+            Layout<T_val>::describe(out, open);
+        }
+        template<typename Sink>
+        static void encode(Output<Sink>& out, const Holder& cpp_val) {
+            out.byte(cpp_val ? 1 : 0);
+            if (cpp_val) Layout<T_val>::encode(out, *cpp_val);
+        }
+        static bool decode(Input& in, Holder& cpp_val) {
+            bool present;
+            if (!Layout<bool>::decode(in, present)) return false;
+            if (!present) {
+                cpp_val.reset();
+                return true;
+            }
+            if constexpr (std::is_same_v<Holder, std::optional<T_val>>) {
+                if (!cpp_val) cpp_val.emplace();
+            } else if constexpr (std::is_same_v<Holder, std::unique_ptr<T_val>>) {
+                if (!cpp_val) cpp_val = std::make_unique<T_val>();
+            } else {
+                // Never decode into an object someone else may share.
+                cpp_val = std::make_shared<T_val>();
+            }
+            return Layout<T_val>::decode(in, *cpp_val);
+        }
+    };
+
+    template<typename T_val>
+    struct Layout<std::optional<T_val>, void> : NullableLayout<std::optional<T_val>, T_val> {};
+
+    template<typename T_val>
+    struct Layout<std::unique_ptr<T_val>, void> : NullableLayout<std::unique_ptr<T_val>, T_val> {};
+
+    template<typename T_val>
+    struct Layout<std::shared_ptr<T_val>, void> : NullableLayout<std::shared_ptr<T_val>, T_val> {};
+
+    // The alternative's index, then its value.  No kind checks or tags are
+    // needed: the index says which alternative it is.
+    template<typename... Types>
+    struct Layout<std::variant<Types...>, void> {
+        using Variant = std::variant<Types...>;
+        static_assert(sizeof...(Types) < 256, "too many alternatives");
+
+        static void describe(std::string& out, Describing& open) {
+            out += '<';
+            bool first = true;
+            ((out += first ? "" : "|", first = false, Layout<Types>::describe(out, open)), ...);
+            out += '>';
+        }
+        template<typename Sink>
+        static void encode(Output<Sink>& out, const Variant& cpp_val) {
+            out.byte(static_cast<std::uint8_t>(cpp_val.index()));
+            std::visit([&](const auto& arg) { Layout<std::decay_t<decltype(arg)>>::encode(out, arg); }, cpp_val);
+        }
+        static bool decode(Input& in, Variant& cpp_val) {
+            const std::uint8_t* b = in.take(1);
+            if (!b) return false;
+            if (*b >= sizeof...(Types)) return in.fail();
+            return decode_alternative(in, *b, cpp_val, std::index_sequence_for<Types...>{});
+        }
+
+    private:
+        template<std::size_t... Is>
+        static bool decode_alternative(Input& in, std::size_t index, Variant& cpp_val, std::index_sequence<Is...>) {
+            bool success = false;
+            ((index == Is ? (success = decode_as<Is>(in, cpp_val), true) : false) || ...);
+            return success;
+        }
+
+        template<std::size_t I>
+        static bool decode_as(Input& in, Variant& cpp_val) {
+            using Alt = std::variant_alternative_t<I, Variant>;
+            if (cpp_val.index() != I) cpp_val.template emplace<I>();
+            return Layout<Alt>::decode(in, std::get<I>(cpp_val));
+        }
+    };
+
+    // Structs: the fields in config_fields() order, with no keys.
+    template<typename T>
+    struct Layout<T, std::enable_if_t<has_config_fields<T>::value>> {
+        static void describe(std::string& out, Describing& open) {
+            const void* self = &field_table<T>();
+            for (std::size_t depth = open.size(); depth-- > 0;) {
+                if (open[depth] == self) {
+                    // Recursive: refer to the enclosing struct by distance.
+                    out += '^';
+                    out += std::to_string(open.size() - depth);
+                    return;
+                }
+            }
+            open.push_back(self);
+            out += '(';
+            bool first = true;
+            std::apply([&](const auto&... field) {
+                ((out += first ? "" : ",", first = false, out += field.name, out += ':',
+                  Layout<std::decay_t<decltype(std::declval<T&>().*field.ptr_to_member)>>::describe(out, open)), ...);
+            }, field_table<T>());
+            out += ')';
+            open.pop_back();
+        }
+        template<typename Sink>
+        static void encode(Output<Sink>& out, const T& obj) {
+            std::apply([&](const auto&... field) {
+                (Layout<std::decay_t<decltype(obj.*field.ptr_to_member)>>::encode(out, obj.*field.ptr_to_member), ...);
+            }, field_table<T>());
+        }
+        static bool decode(Input& in, T& obj) {
+            return std::apply([&](const auto&... field) {
+                return (Layout<std::decay_t<decltype(obj.*field.ptr_to_member)>>::decode(in, obj.*field.ptr_to_member) && ...);
+            }, field_table<T>());
+        }
+    };
+
+    /// T's schema as text, e.g. "(host:s,port:i32,tags:[s])".  Built once.
+    template<typename T>
+    const std::string& schema() {
+        static const std::string text = [] {
+            std::string out;
+            Describing open;
+            Layout<T>::describe(out, open);
+            return out;
+        }();
+        return text;
+    }
+
+    /// A 64-bit FNV-1a hash of schema<T>().  Field names are only known
+    /// once config_fields() has run, so it is computed on first use rather
+    /// than by the compiler.
+    template<typename T>
+    std::uint64_t fingerprint() {
+        static const std::uint64_t hash = fnv1a(schema<T>());
+        return hash;
+    }
+
+    /// The header which starts every stream: a magic number and the
+    /// fingerprint of the record type.
+    inline constexpr std::array<std::uint8_t, 4> magic{'J', 'S', 'P', '1'};
+    inline constexpr std::size_t header_size = magic.size() + 8;
+
+    /// Writes a stream of T records to a Sink.
+    template<typename T, typename Sink>
+    class RecordWriter {
+    public:
+        /// Write the header.
+        explicit RecordWriter(Sink& sink) : out_(sink) {
+            out_.bytes(magic.data(), magic.size());
+            out_.fixed(fingerprint<T>());
+        }
+
+        void write(const T& record) { Layout<T>::encode(out_, record); }
+
+    private:
+        Output<Sink> out_;
+    };
+
+    /// Reads a stream of T records.  Strings decoded as std::string_view
+    /// point into the input, which must outlive them.
+    template<typename T>
+    class RecordReader {
+    public:
+        /// Check the header.  If it is not T's, valid() is false and there
+        /// are no records.
+        RecordReader(const std::uint8_t* data, std::size_t size) : in_(data, size) {
+            const std::uint8_t* header = in_.take(header_size);
+            valid_ = header && std::memcmp(header, magic.data(), magic.size()) == 0
+                && Input::load<std::uint64_t>(header + magic.size()) == fingerprint<T>();
+        }
+        explicit RecordReader(const std::vector<std::uint8_t>& bytes) : RecordReader(bytes.data(), bytes.size()) {}
+
+        bool valid() const { return valid_; }
+        bool failed() const { return !valid_ || in_.failed(); }
+        bool at_end() const { return in_.at_end(); }
+
+        /// Decode the next record, if there is one.  Returns false at the
+        /// end of the stream or on failure (see failed()).
+        bool next(T& record) {
+            if (!valid_ || in_.at_end()) return false;
+            return Layout<T>::decode(in_, record) || fail(Errc::syntax);
+        }
+
+    private:
+        Input in_;
+        bool valid_;
+    };
+
+    /// Pack records into one stream.
+    template<typename T>
+    std::vector<std::uint8_t> pack(const std::vector<T>& records) {
+        std::vector<std::uint8_t> bytes;
+        RecordWriter<T, std::vector<std::uint8_t>> writer(bytes);
+        for (const auto& record : records) writer.write(record);
+        return bytes;
+    }
+
+    /// Unpack a whole stream into records.  False if its schema is not T's
+    /// (Errc::type_mismatch) or it is malformed (Errc::syntax, at the
+    /// record's index).
+    template<typename T>
+    bool unpack(const std::uint8_t* data, std::size_t size, std::vector<T>& records) {
+        RecordReader<T> reader(data, size);
+        records.clear();
+        if (!reader.valid()) return fail(Errc::type_mismatch);
+        while (!reader.at_end()) {
+            records.emplace_back();
+            if (!reader.next(records.back())) return fail_in(records.size() - 1);
+        }
+        return true;
+    }
+
+    template<typename T>
+    bool unpack(const std::vector<std::uint8_t>& bytes, std::vector<T>& records) {
+        return unpack(bytes.data(), bytes.size(), records);
+    }
+}
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <jsonstruct/instrument.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jsonstruct::profile {
+
+    /// What was recorded for one field path.  Times, allocations and
+    /// bytes produced include those of the nested fields and elements.
+    /// produced_bytes is the length of the text a value was written as,
+    /// counted when encoding through a profile::Sink; the DOM converters
+    /// write no text and leave it 0.
+    struct Counts {
+        std::uint64_t calls = 0;
+        std::uint64_t nanoseconds = 0;
+        std::uint64_t allocations = 0;
+        std::uint64_t allocated_bytes = 0;
+        std::uint64_t produced_bytes = 0;
+        std::uint64_t variant_retries = 0;
+
+        Counts& operator+=(const Counts& other) {
+            calls += other.calls;
+            nanoseconds += other.nanoseconds;
+            allocations += other.allocations;
+            allocated_bytes += other.allocated_bytes;
+            produced_bytes += other.produced_bytes;
+            variant_retries += other.variant_retries;
+            return *this;
+        }
+    };
+
+    /// Reports the running totals of allocations and bytes allocated, as
+    /// counted by the program (by replacing operator new, say).  Profile
+    /// records the difference across each field.
+    using AllocationCounter = void (*)(std::uint64_t& allocations, std::uint64_t& bytes);
+
+    /// Counts for each field path converted by the instrumented Traits
+    /// (profile::Traits) on the threads it is the Session of.
+    ///
+    /// Paths are JSON pointers from the value converted, with "*" for
+    /// any element of an array or value of a map, so the elements of a
+    /// vector add up to one path.  One Profile is meant for one thread at a
+    /// time; give each thread its own and merge() them to report.
+    class Profile {
+    public:
+        explicit Profile(AllocationCounter counter = nullptr) : counter_(counter) {}
+
+        /// Counts by path, for decoding or encoding.
+        std::map<std::string, Counts> stats(Phase phase) const {
+            std::map<std::string, Counts> out;
+            std::string path;
+            collect(roots_[index(phase)], path, out);
+            return out;
+        }
+
+        /// Add other's counts to this one's.
+        void merge(const Profile& other) {
+            for (int p = 0; p < 2; ++p) merge(roots_[p], other.roots_[p]);
+        }
+
+        void clear() {
+            for (auto& root : roots_) root = Node{};
+        }
+
+        /// The stats as JSON:
+        ///
+        ///     {"decode": {"/path": {"calls": ..., "nanoseconds": ..., ...}, ...},
+        ///      "encode": {...}}
+        std::string to_json() const {
+            std::string out = "{";
+            const char* names[] = {"decode", "encode"};
+            for (int p = 0; p < 2; ++p) {
+                if (p) out += ',';
+                append_string(out, names[p]);
+                out += ":{";
+                bool first = true;
+                for (const auto& [path, counts] : stats(static_cast<Phase>(p))) {
+                    if (!first) out += ',';
+                    first = false;
+                    append_string(out, path);
+                    out += ":{\"calls\":" + std::to_string(counts.calls)
+                        + ",\"nanoseconds\":" + std::to_string(counts.nanoseconds)
+                        + ",\"allocations\":" + std::to_string(counts.allocations)
+                        + ",\"allocated_bytes\":" + std::to_string(counts.allocated_bytes)
+                        + ",\"produced_bytes\":" + std::to_string(counts.produced_bytes)
+                        + ",\"variant_retries\":" + std::to_string(counts.variant_retries) + '}';
+                }
+                out += '}';
+            }
+            out += '}';
+            return out;
+        }
+
+    private:
+        friend struct Hooks;
+
+        // Children are told apart by the address of their name: field
+        // names and any_element are static strings, so this is one pointer
+        // compare per child.
+        struct Node {
+            const char* name = nullptr;
+            Counts counts;
+            std::vector<std::unique_ptr<Node>> children;
+
+            Node* child(const char* child_name) {
+                for (auto& c : children) {
+                    if (c->name == child_name) return c.get();
+                }
+                children.push_back(std::make_unique<Node>());
+                children.back()->name = child_name;
+                return children.back().get();
+            }
+        };
+
+        static int index(Phase phase) { return phase == Phase::decode ? 0 : 1; }
+
+        static void collect(const Node& node, std::string& path, std::map<std::string, Counts>& out) {
+            if (node.counts.calls || node.counts.variant_retries) out[path] += node.counts;
+            for (const auto& c : node.children) {
+                const std::size_t size = path.size();
+                path += '/';
+                for (const char* ch = c->name; *ch; ++ch) {
+                    if (*ch == '~') path += "~0";
+                    else if (*ch == '/') path += "~1";
+                    else path += *ch;
+                }
+                collect(*c, path, out);
+                path.resize(size);
+            }
+        }
+
+        static void merge(Node& into, const Node& from) {
+            into.counts += from.counts;
+            for (const auto& c : from.children) merge(*into.child(c->name), *c);
+        }
+
+        static void append_string(std::string& out, const std::string& s) {
+            static const char hex[] = "0123456789abcdef";
+            out += '"';
+            for (char c : s) {
+                if (c == '"' || c == '\\') {
+                    out += '\\';
+                    out += c;
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    out += "\\u00";
+                    out += hex[(c >> 4) & 0xf];
+                    out += hex[c & 0xf];
+                } else {
+                    out += c;
+                }
+            }
+            out += '"';
+        }
+
+        Node roots_[2];
+        Node* cursor_{nullptr};     // the innermost open Scope's node
+        AllocationCounter counter_;
+    };
+
+    // The Profile this thread records into, if any.
+    inline Profile*& current() {
+        thread_local Profile* profile = nullptr;
+        return profile;
+    }
+
+    /// Makes profile the one which this thread's instrumented conversions
+    /// record into, until destroyed.  Without a Session they record nothing.
+    class Session {
+    public:
+        explicit Session(Profile& profile) : previous_(current()) { current() = &profile; }
+        ~Session() { current() = previous_; }
+        Session(const Session&) = delete;
+        Session& operator=(const Session&) = delete;
+
+    private:
+        Profile* previous_;
+    };
+
+    /// The hooks which record into the current Profile.
+    struct Hooks {
+        class Scope {
+        public:
+            Scope(const char* name, Phase phase) : profile_(current()) {
+                if (!profile_) return;
+                parent_ = profile_->cursor_;
+                node_ = (parent_ ? parent_ : &profile_->roots_[Profile::index(phase)])->child(name);
+                profile_->cursor_ = node_;
+                if (profile_->counter_) profile_->counter_(allocations_, bytes_);
+                start_ = std::chrono::steady_clock::now();
+            }
+
+            ~Scope() {
+                if (!profile_) return;
+                const auto elapsed = std::chrono::steady_clock::now() - start_;
+                Counts& counts = node_->counts;
+                ++counts.calls;
+                counts.nanoseconds += static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+                if (profile_->counter_) {
+                    std::uint64_t allocations, bytes;
+                    profile_->counter_(allocations, bytes);
+                    counts.allocations += allocations - allocations_;
+                    counts.allocated_bytes += bytes - bytes_;
+                }
+                profile_->cursor_ = parent_;
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+            void produced(std::size_t bytes) {
+                if (profile_) node_->counts.produced_bytes += bytes;
+            }
+
+        private:
+            Profile* profile_;
+            Profile::Node* parent_{nullptr};
+            Profile::Node* node_{nullptr};
+            std::uint64_t allocations_{0};
+            std::uint64_t bytes_{0};
+            std::chrono::steady_clock::time_point start_;
+        };
+
+        static void variant_retry() {
+            if (Profile* profile = current()) {
+                Profile::Node* node = profile->cursor_ ? profile->cursor_ : &profile->roots_[0];
+                ++node->counts.variant_retries;
+            }
+        }
+    };
+
+    /// Base (jsoncpp::Traits, nlohmannjson::Traits, ...) with Hooks: the
+    /// DOM converters then record into the current Session's Profile.
+    ///
+    ///     profile::Profile stats;
+    ///     profile::Session session(stats);
+    ///     Converter<Config, profile::Traits<nlohmannjson::Traits>>::fromJson(json, config);
+    ///     std::string report = stats.to_json();
+    ///
+    /// Plain Base does none of this, at no cost.
+    template<typename Base>
+    struct Traits : Base {
+        using Instrumentation = Hooks;
+    };
+
+    /// A stream writer Sink which writes to base, selecting Hooks: the
+    /// stream encoders then record into the current Session's Profile,
+    /// with the bytes each field path produced, from the count kept here.
+    ///
+    ///     std::string text;
+    ///     profile::Sink<std::string> sink(text);
+    ///     stream::write_json(config, sink);
+    template<typename Base>
+    class Sink {
+    public:
+        using Instrumentation = Hooks;
+
+        explicit Sink(Base& base) : base_(base) {}
+        void push_back(char c) { base_.push_back(c); ++size_; }
+        void append(const char* s, std::size_t n) { base_.append(s, n); size_ += n; }
+        std::size_t size() const { return size_; }
+
+    private:
+        Base& base_;
+        std::size_t size_{0};
+    };
+}
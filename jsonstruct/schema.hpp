@@ -0,0 +1,584 @@
+#pragma once
+
+#include <jsonstruct/converter.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace jsonstruct {
+
+    // Two views of the rules the DOM converters apply, generated from the
+    // same types and config_fields():
+    //
+    // - json_schema<T, Traits>(): a JSON Schema (draft 2020-12) of the
+    //   JSON which converts to a T, to hand to producers.
+    //
+    // - validate<T, Traits>(json): whether json would convert to a T,
+    //   checked without building one, so that bad input is turned away
+    //   before anything is allocated or copied.
+    //
+    // Both follow the Converter specializations, one Schema and one
+    // Validator for each.  A type with a Converter of its own and neither
+    // (Columns<T>, say) is described by the empty schema, which allows
+    // anything, and validated by converting into a temporary.
+
+    // The structs being described, outermost first, with the JSON pointer
+    // of their schema, so that a recursive struct refers back to it with
+    // "$ref" rather than being described forever.  A tagged variant's
+    // alternative, which also carries its tag, is kept apart from the
+    // same struct untagged.
+    struct SchemaContext {
+        struct Open {
+            const void* type;
+            const char* tag;
+            std::string at;
+        };
+        std::vector<Open> open;
+    };
+
+    // The JSON pointer of member (or keyword) segment below at.
+    inline std::string schema_pointer(const std::string& at, std::string_view segment) {
+        std::string out = at;
+        out += '/';
+        for (char c : segment) {
+            if (c == '~') out += "~0";
+            else if (c == '/') out += "~1";
+            else out += c;
+        }
+        return out;
+    }
+
+    // A "$ref" URI for pointer: the pointer as a fragment, with the bytes
+    // a fragment may not hold percent-encoded.
+    inline std::string schema_ref(std::string_view pointer) {
+        static const char hex[] = "0123456789ABCDEF";
+        std::string out = "#";
+        for (char c : pointer) {
+            const auto u = static_cast<unsigned char>(c);
+            if ((u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9')
+                || std::string_view("-._~!$&'()*+,;=:@/").find(c) != std::string_view::npos) {
+                out += c;
+            } else {
+                out += '%';
+                out += hex[u >> 4];
+                out += hex[u & 0xf];
+            }
+        }
+        return out;
+    }
+
+    // {"type": type}
+    template<typename JsonLibTraits>
+    typename JsonLibTraits::ValueType schema_type(const char* type) {
+        auto obj = JsonLibTraits::create_object();
+        JsonLibTraits::set_member(obj, "type", JsonLibTraits::create_static_string(type));
+        return obj;
+    }
+
+    // The schema of T's JSON; `at` is its JSON pointer in the whole schema.
+    template<typename T, typename JsonLibTraits, typename Enable = void>
+    struct Schema {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        static JsonValueType describe(SchemaContext&, const std::string&) { return JsonLibTraits::create_object(); }
+    };
+
+    // An integer within the type's range.
+    template<typename T, typename JsonLibTraits>
+    struct Schema<T, JsonLibTraits, std::enable_if_t<is_number_type<T>::value && std::is_integral_v<T>>> {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        static JsonValueType describe(SchemaContext&, const std::string&) {
+            JsonValueType obj = schema_type<JsonLibTraits>("integer");
+            if constexpr (std::is_signed_v<T>) {
+                JsonLibTraits::set_member(obj, "minimum", JsonLibTraits::create_int64(std::numeric_limits<T>::min()));
+                JsonLibTraits::set_member(obj, "maximum", JsonLibTraits::create_int64(std::numeric_limits<T>::max()));
+            } else {
+                JsonLibTraits::set_member(obj, "minimum", JsonLibTraits::create_int64(0));
+                JsonLibTraits::set_member(obj, "maximum", JsonLibTraits::create_uint64(std::numeric_limits<T>::max()));
+            }
+            return obj;
+        }
+    };
+
+    // Any number, within float's range for a float.
+    template<typename T, typename JsonLibTraits>
+    struct Schema<T, JsonLibTraits, std::enable_if_t<std::is_floating_point_v<T>>> {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        static JsonValueType describe(SchemaContext&, const std::string&) {
+            JsonValueType obj = schema_type<JsonLibTraits>("number");
+            if constexpr (sizeof(T) < sizeof(double)) {
+                const double max = std::numeric_limits<T>::max();
+                JsonLibTraits::set_member(obj, "minimum", JsonLibTraits::create_double(-max));
+                JsonLibTraits::set_member(obj, "maximum", JsonLibTraits::create_double(max));
+            }
+            return obj;
+        }
+    };
+
+    template<typename JsonLibTraits>
+    struct Schema<bool, JsonLibTraits, void> {
+        static typename JsonLibTraits::ValueType describe(SchemaContext&, const std::string&) {
+            return schema_type<JsonLibTraits>("boolean");
+        }
+    };
+
+    template<typename JsonLibTraits>
+    struct Schema<std::string_view, JsonLibTraits, void> {
+        static typename JsonLibTraits::ValueType describe(SchemaContext&, const std::string&) {
+            return schema_type<JsonLibTraits>("string");
+        }
+    };
+
+    template<typename Alloc, typename JsonLibTraits>
+    struct Schema<std::basic_string<char, std::char_traits<char>, Alloc>, JsonLibTraits, void>
+        : Schema<std::string_view, JsonLibTraits, void> {};
+
+    // One of E's names, or any value of its underlying type.
+    template<typename E, typename JsonLibTraits>
+    typename JsonLibTraits::ValueType enum_schema(SchemaContext& ctx, const std::string& at) {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        JsonValueType names = JsonLibTraits::create_array();
+        for (const auto& entry : EnumNames<E>::entries) {
+            JsonLibTraits::append_array_element(names, JsonLibTraits::create_static_string(entry.second));
+        }
+        JsonValueType by_name = JsonLibTraits::create_object();
+        JsonLibTraits::set_member(by_name, "enum", std::move(names));
+        JsonValueType any = JsonLibTraits::create_array();
+        JsonLibTraits::append_array_element(any, std::move(by_name));
+        JsonLibTraits::append_array_element(any,
+            Schema<std::underlying_type_t<E>, JsonLibTraits>::describe(ctx, schema_pointer(schema_pointer(at, "anyOf"), "1")));
+        JsonValueType obj = JsonLibTraits::create_object();
+        JsonLibTraits::set_member(obj, "anyOf", std::move(any));
+        return obj;
+    }
+
+    template<typename E, typename JsonLibTraits>
+    struct Schema<E, JsonLibTraits, std::enable_if_t<has_enum_names<E>::value>> {
+        static typename JsonLibTraits::ValueType describe(SchemaContext& ctx, const std::string& at) {
+            return enum_schema<E, JsonLibTraits>(ctx, at);
+        }
+    };
+
+    // An array of flag names and integers.
+    template<typename E, typename JsonLibTraits>
+    struct Schema<E, JsonLibTraits, std::enable_if_t<has_flag_names<E>::value>> {
+        static typename JsonLibTraits::ValueType describe(SchemaContext& ctx, const std::string& at) {
+            auto obj = schema_type<JsonLibTraits>("array");
+            JsonLibTraits::set_member(obj, "items", enum_schema<E, JsonLibTraits>(ctx, schema_pointer(at, "items")));
+            return obj;
+        }
+    };
+
+    template<typename Container, typename JsonLibTraits>
+    struct SequenceSchema {
+        static typename JsonLibTraits::ValueType describe(SchemaContext& ctx, const std::string& at) {
+            auto obj = schema_type<JsonLibTraits>("array");
+            JsonLibTraits::set_member(obj, "items",
+                Schema<typename Container::value_type, JsonLibTraits>::describe(ctx, schema_pointer(at, "items")));
+            return obj;
+        }
+    };
+
+    template<typename T_elem, typename Alloc, typename JsonLibTraits>
+    struct Schema<std::vector<T_elem, Alloc>, JsonLibTraits, void>
+        : SequenceSchema<std::vector<T_elem, Alloc>, JsonLibTraits> {};
+
+    template<typename T_elem, typename Alloc, typename JsonLibTraits>
+    struct Schema<std::deque<T_elem, Alloc>, JsonLibTraits, void>
+        : SequenceSchema<std::deque<T_elem, Alloc>, JsonLibTraits> {};
+
+    template<typename T_elem, std::size_t N, typename JsonLibTraits>
+    struct Schema<std::array<T_elem, N>, JsonLibTraits, void> {
+        static typename JsonLibTraits::ValueType describe(SchemaContext& ctx, const std::string& at) {
+            auto obj = SequenceSchema<std::array<T_elem, N>, JsonLibTraits>::describe(ctx, at);
+            JsonLibTraits::set_member(obj, "minItems", JsonLibTraits::create_uint64(N));
+            JsonLibTraits::set_member(obj, "maxItems", JsonLibTraits::create_uint64(N));
+            return obj;
+        }
+    };
+
+    template<typename Map, typename JsonLibTraits>
+    struct MapSchema {
+        static typename JsonLibTraits::ValueType describe(SchemaContext& ctx, const std::string& at) {
+            auto obj = schema_type<JsonLibTraits>("object");
+            JsonLibTraits::set_member(obj, "additionalProperties",
+                Schema<typename Map::mapped_type, JsonLibTraits>::describe(ctx, schema_pointer(at, "additionalProperties")));
+            return obj;
+        }
+    };
+
+    template<typename KeyAlloc, typename T_val, typename Compare, typename Alloc, typename JsonLibTraits>
+    struct Schema<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>, JsonLibTraits, void>
+        : MapSchema<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>, JsonLibTraits> {};
+
+    template<typename KeyAlloc, typename T_val, typename Hash, typename Equal, typename Alloc, typename JsonLibTraits>
+    struct Schema<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>, JsonLibTraits, void>
+        : MapSchema<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>, JsonLibTraits> {};
+
+    // Null, and for an optional the empty {} and [] too, or the value.
+    template<typename T_val, typename JsonLibTraits, bool empty_is_null>
+    typename JsonLibTraits::ValueType nullable_schema(SchemaContext& ctx, const std::string& at) {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        JsonValueType any = JsonLibTraits::create_array();
+        JsonLibTraits::append_array_element(any, schema_type<JsonLibTraits>("null"));
+        std::size_t alternatives = 1;
+        if constexpr (empty_is_null) {
+            JsonValueType empty_object = schema_type<JsonLibTraits>("object");
+            JsonLibTraits::set_member(empty_object, "maxProperties", JsonLibTraits::create_int64(0));
+            JsonLibTraits::append_array_element(any, std::move(empty_object));
+            JsonValueType empty_array = schema_type<JsonLibTraits>("array");
+            JsonLibTraits::set_member(empty_array, "maxItems", JsonLibTraits::create_int64(0));
+            JsonLibTraits::append_array_element(any, std::move(empty_array));
+            alternatives = 3;
+        }
+        JsonLibTraits::append_array_element(any,
+            Schema<T_val, JsonLibTraits>::describe(ctx, schema_pointer(schema_pointer(at, "anyOf"), std::to_string(alternatives))));
+        JsonValueType obj = JsonLibTraits::create_object();
+        JsonLibTraits::set_member(obj, "anyOf", std::move(any));
+        return obj;
+    }
+
+    template<typename T_val, typename JsonLibTraits>
+    struct Schema<std::optional<T_val>, JsonLibTraits, void> {
+        static typename JsonLibTraits::ValueType describe(SchemaContext& ctx, const std::string& at) {
+            return nullable_schema<T_val, JsonLibTraits, true>(ctx, at);
+        }
+    };
+
+    template<typename T_val, typename JsonLibTraits>
+    struct Schema<std::unique_ptr<T_val>, JsonLibTraits, void> {
+        static typename JsonLibTraits::ValueType describe(SchemaContext& ctx, const std::string& at) {
+            return nullable_schema<T_val, JsonLibTraits, false>(ctx, at);
+        }
+    };
+
+    template<typename T_val, typename JsonLibTraits>
+    struct Schema<std::shared_ptr<T_val>, JsonLibTraits, void> {
+        static typename JsonLibTraits::ValueType describe(SchemaContext& ctx, const std::string& at) {
+            return nullable_schema<T_val, JsonLibTraits, false>(ctx, at);
+        }
+    };
+
+    // Untagged: "anyOf" the alternatives.  Tagged: "oneOf" them, each
+    // requiring the tag member to hold its own tag.
+    template<typename... Types, typename JsonLibTraits>
+    struct Schema<std::variant<Types...>, JsonLibTraits, void> {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        static JsonValueType describe(SchemaContext& ctx, const std::string& at) {
+            constexpr bool tagged = is_tagged_variant<Types...>;
+            const std::string keyword = tagged ? "oneOf" : "anyOf";
+            const std::string alternatives_at = schema_pointer(at, keyword);
+            JsonValueType alternatives = JsonLibTraits::create_array();
+            std::size_t i = 0;
+            (JsonLibTraits::append_array_element(alternatives,
+                alternative<Types>(ctx, schema_pointer(alternatives_at, std::to_string(i++)))), ...);
+            JsonValueType obj = JsonLibTraits::create_object();
+            JsonLibTraits::set_member(obj, keyword.c_str(), std::move(alternatives));
+            return obj;
+        }
+
+    private:
+        template<typename Alt>
+        static JsonValueType alternative(SchemaContext& ctx, const std::string& at) {
+            if constexpr (is_tagged_variant<Types...>) {
+                return Schema<Alt, JsonLibTraits>::describe(ctx, at, variant_tag_key<Types...>, Alt::json_tag);
+            } else {
+                return Schema<Alt, JsonLibTraits>::describe(ctx, at);
+            }
+        }
+    };
+
+    // An object with a property for each field.  Fields without a default
+    // are "required"; the others carry their "default".
+    template<typename T, typename JsonLibTraits>
+    struct Schema<T, JsonLibTraits, std::enable_if_t<has_config_fields<T>::value>> {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        static JsonValueType describe(SchemaContext& ctx, const std::string& at,
+                                      const char* tag_key = nullptr, const char* tag = nullptr) {
+            const void* self = &field_table<T>();
+            for (const auto& open : ctx.open) {
+                if (open.type == self && open.tag == tag) {
+                    JsonValueType ref = JsonLibTraits::create_object();
+                    JsonLibTraits::set_member(ref, "$ref", JsonLibTraits::create_string(schema_ref(open.at)));
+                    return ref;
+                }
+            }
+            ctx.open.push_back(SchemaContext::Open{self, tag, at});
+
+            JsonValueType properties = JsonLibTraits::create_object();
+            JsonValueType required = JsonLibTraits::create_array();
+            if (tag_key) {
+                JsonValueType is_tag = JsonLibTraits::create_object();
+                JsonLibTraits::set_member(is_tag, "const", JsonLibTraits::create_string(std::string_view(tag)));
+                JsonLibTraits::set_member(properties, tag_key, std::move(is_tag));
+                JsonLibTraits::append_array_element(required, JsonLibTraits::create_string(std::string_view(tag_key)));
+            }
+            const std::string properties_at = schema_pointer(at, "properties");
+            std::apply([&](const auto&... field) {
+                (describe_field(ctx, properties_at, field, properties, required), ...);
+            }, field_table<T>());
+
+            JsonValueType obj = schema_type<JsonLibTraits>("object");
+            JsonLibTraits::set_member(obj, "properties", std::move(properties));
+            if (JsonLibTraits::array_size(required)) JsonLibTraits::set_member(obj, "required", std::move(required));
+            ctx.open.pop_back();
+            return obj;
+        }
+
+    private:
+        template<typename Member>
+        static void describe_field(SchemaContext& ctx, const std::string& properties_at, const Field<T, Member>& field,
+                                   JsonValueType& properties, JsonValueType& required) {
+            JsonValueType prop = Schema<Member, JsonLibTraits>::describe(ctx, schema_pointer(properties_at, field.name));
+            if (field.is_required) {
+                JsonLibTraits::append_array_element(required, JsonLibTraits::create_string(std::string_view(field.name)));
+            }
+            // The default as Field::default_into() applies it.
+            if constexpr (std::is_copy_assignable_v<Member>) {
+                const Member* value = field.default_value ? &*field.default_value : nullptr;
+                if (field.default_from) value = &(field.default_from->*field.ptr_to_member);
+                if (value) JsonLibTraits::set_member(prop, "default", Converter<Member, JsonLibTraits, void>::toJson(*value));
+            }
+            JsonLibTraits::set_member(properties, field.name, std::move(prop));
+        }
+    };
+
+    /// A JSON Schema (draft 2020-12) for the JSON which
+    /// Converter<T, JsonLibTraits>::fromJson() accepts, as a JSON value of
+    /// the library; dump it to share it.
+    ///
+    ///     nlohmann::json schema = json_schema<ServerConfig, nlohmannjson::Traits>();
+    ///
+    /// Types, ranges of integers, enum names, required fields, defaults and
+    /// variant alternatives are all described.  The empty {} or [] which an
+    /// optional also takes for "no value" is listed as such.
+    template<typename T, typename JsonLibTraits>
+    typename JsonLibTraits::ValueType json_schema() {
+        SchemaContext ctx;
+        auto schema = Schema<T, JsonLibTraits>::describe(ctx, "");
+        if (JsonLibTraits::is_object(schema)) {
+            JsonLibTraits::set_member(schema, "$schema",
+                JsonLibTraits::create_static_string("https://json-schema.org/draft/2020-12/schema"));
+        }
+        return schema;
+    }
+
+    // --- Validation ---
+    //
+    // Validator<T, JsonLibTraits>::check(j_val) is true where
+    // Converter<T, JsonLibTraits>::fromJson() would be, and records the
+    // same Errc and path through fail() and fail_in() where it would not.
+    // Nothing is built: values are only looked at, except numbers, bools
+    // and enums, which are converted into a local as the check costs no
+    // more than that.
+
+    template<typename T, typename JsonLibTraits, typename Enable = void>
+    struct Validator {
+        static bool check(const typename JsonLibTraits::ValueType& j_val) {
+            T temp{};
+            return Converter<T, JsonLibTraits, void>::fromJson(j_val, temp);
+        }
+    };
+
+    template<typename JsonLibTraits>
+    struct Validator<std::string_view, JsonLibTraits, void> {
+        static bool check(const typename JsonLibTraits::ValueType& j_val) {
+            return JsonLibTraits::is_string(j_val) || fail(Errc::type_mismatch);
+        }
+    };
+
+    template<typename Alloc, typename JsonLibTraits>
+    struct Validator<std::basic_string<char, std::char_traits<char>, Alloc>, JsonLibTraits, void>
+        : Validator<std::string_view, JsonLibTraits, void> {};
+
+    // Each element, stopping at the first which fails.
+    template<typename T_elem, typename JsonLibTraits>
+    bool check_elements(const typename JsonLibTraits::ValueType& j_val) {
+        std::size_t index = 0;
+        for (const auto& item : j_val) {
+            if (!Validator<T_elem, JsonLibTraits>::check(item)) return fail_in(index);
+            ++index;
+        }
+        return true;
+    }
+
+    template<typename Container, typename JsonLibTraits>
+    struct SequenceValidator {
+        static bool check(const typename JsonLibTraits::ValueType& j_val) {
+            if (!JsonLibTraits::is_array(j_val)) return fail(Errc::type_mismatch);
+            return check_elements<typename Container::value_type, JsonLibTraits>(j_val);
+        }
+    };
+
+    template<typename T_elem, typename Alloc, typename JsonLibTraits>
+    struct Validator<std::vector<T_elem, Alloc>, JsonLibTraits, void>
+        : SequenceValidator<std::vector<T_elem, Alloc>, JsonLibTraits> {};
+
+    template<typename T_elem, typename Alloc, typename JsonLibTraits>
+    struct Validator<std::deque<T_elem, Alloc>, JsonLibTraits, void>
+        : SequenceValidator<std::deque<T_elem, Alloc>, JsonLibTraits> {};
+
+    template<typename T_elem, std::size_t N, typename JsonLibTraits>
+    struct Validator<std::array<T_elem, N>, JsonLibTraits, void> {
+        static bool check(const typename JsonLibTraits::ValueType& j_val) {
+            if (!JsonLibTraits::is_array(j_val) || JsonLibTraits::array_size(j_val) != N) return fail(Errc::type_mismatch);
+            return check_elements<T_elem, JsonLibTraits>(j_val);
+        }
+    };
+
+    template<typename Map, typename JsonLibTraits>
+    struct MapValidator {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        static bool check(const JsonValueType& j_val) {
+            if (!JsonLibTraits::is_object(j_val)) return fail(Errc::type_mismatch);
+            bool success = true;
+            JsonLibTraits::for_each_object_member(j_val, [&](std::string_view key, const JsonValueType& item) {
+                if (!success) return;
+                success = Validator<typename Map::mapped_type, JsonLibTraits>::check(item) || fail_in(key);
+            });
+            return success;
+        }
+    };
+
+    template<typename KeyAlloc, typename T_val, typename Compare, typename Alloc, typename JsonLibTraits>
+    struct Validator<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>, JsonLibTraits, void>
+        : MapValidator<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>, JsonLibTraits> {};
+
+    template<typename KeyAlloc, typename T_val, typename Hash, typename Equal, typename Alloc, typename JsonLibTraits>
+    struct Validator<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>, JsonLibTraits, void>
+        : MapValidator<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>, JsonLibTraits> {};
+
+    template<typename T_val, typename JsonLibTraits>
+    struct Validator<std::optional<T_val>, JsonLibTraits, void> {
+        static bool check(const typename JsonLibTraits::ValueType& j_val) {
+            if (JsonLibTraits::is_null(j_val) || (JsonLibTraits::is_object(j_val) && j_val.empty()) || (JsonLibTraits::is_array(j_val) && j_val.empty())) {
+                return true;
+            }
+            return Validator<T_val, JsonLibTraits>::check(j_val);
+        }
+    };
+
+    template<typename T_val, typename JsonLibTraits>
+    struct Validator<std::unique_ptr<T_val>, JsonLibTraits, void> {
+        static bool check(const typename JsonLibTraits::ValueType& j_val) {
+            return JsonLibTraits::is_null(j_val) || Validator<T_val, JsonLibTraits>::check(j_val);
+        }
+    };
+
+    template<typename T_val, typename JsonLibTraits>
+    struct Validator<std::shared_ptr<T_val>, JsonLibTraits, void>
+        : Validator<std::unique_ptr<T_val>, JsonLibTraits, void> {};
+
+    template<typename... Types, typename JsonLibTraits>
+    struct Validator<std::variant<Types...>, JsonLibTraits, void> {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        static bool check(const JsonValueType& j_val) {
+            if constexpr (is_tagged_variant<Types...>) {
+                if (!JsonLibTraits::is_object(j_val)) return fail(Errc::type_mismatch);
+                const auto* tag = JsonLibTraits::find_member(j_val, variant_tag_key<Types...>);
+                if (!tag || !JsonLibTraits::is_string(*tag)) {
+                    fail(tag ? Errc::type_mismatch : Errc::missing_required);
+                    return fail_in(variant_tag_key<Types...>);
+                }
+                const std::string_view name = JsonLibTraits::get_string_view(*tag);
+                bool success = false;
+                if (!((name == Types::json_tag ? (success = Validator<Types, JsonLibTraits>::check(j_val), true) : false) || ...)) {
+                    fail(Errc::variant_no_match);
+                    return fail_in(variant_tag_key<Types...>);
+                }
+                return success;
+            } else {
+                const unsigned kind = kind_of<JsonLibTraits>(j_val);
+                const ErrorMark mark;
+                if (((json_kinds<Types>::value & kind && Validator<Types, JsonLibTraits>::check(j_val)) || ...)) {
+                    mark.restore();
+                    return true;
+                }
+                return fail(Errc::variant_no_match);
+            }
+        }
+    };
+
+    // Each field present, and every required one present.  Fields are
+    // gone through in the order the struct's decode_strategy goes through
+    // them, the present ones before the absent ones, and the failure kept
+    // is the first: the one fromJson() reports.
+    template<typename T, typename JsonLibTraits>
+    struct Validator<T, JsonLibTraits, std::enable_if_t<has_config_fields<T>::value>> {
+        using JsonValueType = typename JsonLibTraits::ValueType;
+        static bool check(const JsonValueType& j_val) {
+            if (!JsonLibTraits::is_object(j_val)) return fail(Errc::type_mismatch);
+            if constexpr (decode_strategy<T>::value == Decode::dispatch) {
+                return dispatch(j_val, std::make_index_sequence<field_count<T>>{});
+            } else {
+                bool converts = true, complete = true;
+                std::apply([&](const auto&... field) {
+                    (lookup(j_val, field, converts, complete), ...);
+                }, field_table<T>());
+                return converts && complete;
+            }
+        }
+
+    private:
+        // A failed member's error is recorded last, so it replaces any of
+        // a missing one.
+        template<typename Member>
+        static void lookup(const JsonValueType& j_val, const Field<T, Member>& field, bool& converts, bool& complete) {
+            if (!converts) return;
+            if (const auto* member_json = JsonLibTraits::find_member(j_val, field.name)) {
+                converts = check_value(*member_json, field);
+            } else if (complete) {
+                complete = absent(field);
+            }
+        }
+
+        template<typename Member>
+        static bool check_value(const JsonValueType& member_json, const Field<T, Member>& field) {
+            return Validator<Member, JsonLibTraits>::check(member_json) || fail_in(field.name);
+        }
+
+        // As Field::default_into(), which fails only if there is no default.
+        template<typename Member>
+        static bool absent(const Field<T, Member>& field) {
+            if (!field.is_required) return true;
+            fail(Errc::missing_required);
+            return fail_in(field.name);
+        }
+
+        template<std::size_t I>
+        static bool check_field(const JsonValueType& member_json) {
+            return check_value(member_json, std::get<I>(field_table<T>()));
+        }
+
+        template<std::size_t... Is>
+        static bool dispatch(const JsonValueType& j_val, std::index_sequence<Is...>) {
+            using Checker = bool (*)(const JsonValueType&);
+            static constexpr Checker checkers[] = {&check_field<Is>..., nullptr};
+            const auto& index = FieldIndex<T>::get();
+
+            std::array<bool, sizeof...(Is)> seen{};
+            bool success = true;
+            JsonLibTraits::for_each_object_member(j_val, [&](std::string_view key, const JsonValueType& value) {
+                const std::size_t i = index.find(key);
+                if (!success || i == FieldIndex<T>::npos) return;
+                seen[i] = true;
+                success = checkers[i](value);
+            });
+            return success && ((seen[Is] || absent(std::get<Is>(field_table<T>()))) && ...);
+        }
+    };
+
+    /// Whether json would convert to a T, found without converting it:
+    /// nothing is allocated or copied, so bad input is cheap to reject.
+    /// On failure last_error() holds the code and path, as it would after
+    /// Converter<T, JsonLibTraits>::fromJson().
+    ///
+    ///     if (!validate<ServerConfig, nlohmannjson::Traits>(json)) return reject(last_error());
+    template<typename T, typename JsonLibTraits>
+    bool validate(const typename JsonLibTraits::ValueType& json) {
+        return Validator<T, JsonLibTraits>::check(json);
+    }
+}
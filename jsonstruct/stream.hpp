@@ -0,0 +1,866 @@
+#pragma once
+
+#include <jsonstruct/converter.hpp>
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace jsonstruct::stream {
+
+    /// A pull reader over a complete JSON text.
+    ///
+    /// Unlike the JsonCPP and nlohmann/json backends no DOM is built: the
+    /// Decoder specializations below pull tokens straight into the C++ value.
+    /// The Reader allocates only for a key or scratch string with escapes
+    /// too long for its reused scratch buffer.  std::variant backtracks by
+    /// seek()ing back to a saved position(), not by copying the Reader,
+    /// which would copy that buffer too.
+    class Reader {
+    public:
+        enum class Kind { null, boolean, number, string, array, object, end, invalid };
+
+        explicit Reader(std::string_view text) : text_(text) {}
+        Reader(const char* data, std::size_t size) : text_(data, size) {}
+
+        bool failed() const { return failed_; }
+        std::size_t position() const { return pos_; }
+
+        /// Return to an earlier position() and clear any failure.
+        void seek(std::size_t pos) { pos_ = pos; failed_ = false; }
+
+        /// Skip whitespace and classify the next value without consuming it.
+        Kind peek() {
+            skip_ws();
+            return kind_at(pos_);
+        }
+
+        /// Classify the value at an earlier position() without moving.
+        Kind kind_at(std::size_t pos) const {
+            while (pos < text_.size() && is_ws(text_[pos])) ++pos;
+            if (pos >= text_.size()) return Kind::end;
+            switch (text_[pos]) {
+            case 'n': return Kind::null;
+            case 't': case 'f': return Kind::boolean;
+            case '"': return Kind::string;
+            case '[': return Kind::array;
+            case '{': return Kind::object;
+            case '-': case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9': return Kind::number;
+            default: return Kind::invalid;
+            }
+        }
+
+        /// True if only whitespace remains.
+        bool at_end() { return peek() == Kind::end; }
+
+        bool null() { return literal("null"); }
+
+        bool boolean(bool& val) {
+            if (peek() == Kind::boolean) {
+                if (text_[pos_] == 't') { val = true; return literal("true"); }
+                val = false; return literal("false");
+            }
+            return fail();
+        }
+
+        /// Consume a number and return its text.  is_integer is true when the
+        /// token has no fraction or exponent.
+        bool number(std::string_view& token, bool& is_integer) {
+            if (peek() != Kind::number) return fail();
+            const std::size_t start = pos_;
+            is_integer = true;
+            if (text_[pos_] == '-') ++pos_;
+            if (pos_ < text_.size() && text_[pos_] == '0') { ++pos_; }
+            else if (!digits()) return fail();
+            if (pos_ < text_.size() && text_[pos_] == '.') {
+                ++pos_; is_integer = false;
+                if (!digits()) return fail();
+            }
+            if (pos_ < text_.size() && (text_[pos_] == 'e' || text_[pos_] == 'E')) {
+                ++pos_; is_integer = false;
+                if (pos_ < text_.size() && (text_[pos_] == '+' || text_[pos_] == '-')) ++pos_;
+                if (!digits()) return fail();
+            }
+            token = text_.substr(start, pos_ - start);
+            return true;
+        }
+
+        /// Consume a whole array of numbers into a std::vector of any
+        /// number type in one loop, without the per-element peek() and
+        /// separator() of next_element().  Accepts exactly what decoding
+        /// each element with Decoder<Num> would.
+        template<typename Vec>
+        bool number_array(Vec& out) {
+            using Num = typename Vec::value_type;
+            if (!expect('[')) return false;
+            out.clear();
+            skip_ws();
+            if (pos_ < text_.size() && text_[pos_] == ']') { ++pos_; return true; }
+            for (;;) {
+                Num val;
+                if constexpr (std::is_same_v<Num, int>) {
+                    if (!integer(val)) return fail();
+                } else {
+                    std::string_view token;
+                    bool is_integer;
+                    if (!number(token, is_integer)) return false;
+                    if (number_value(token, is_integer, val) != Errc::none) return fail();
+                }
+                out.push_back(val);
+                skip_ws();
+                if (pos_ >= text_.size()) return fail();
+                const char c = text_[pos_++];
+                if (c == ']') return true;
+                if (c != ',') return fail();
+                skip_ws();
+            }
+        }
+
+        /// The number token as a Num, or why it can not be one: an
+        /// integral Num takes only an integer token within its range, a
+        /// floating one any number, read as a double and then narrowed.
+        template<typename Num>
+        static Errc number_value(std::string_view token, bool is_integer, Num& val) {
+            const char* first = token.data();
+            const char* last = first + token.size();
+            if constexpr (std::is_integral_v<Num>) {
+                if (!is_integer) return Errc::type_mismatch;
+                if constexpr (std::is_unsigned_v<Num>) {
+                    // from_chars() takes no sign for an unsigned type; "-0"
+                    // is the only negative token which fits.
+                    if (*first == '-') {
+                        if (token.find_first_not_of("-0") != std::string_view::npos) return Errc::out_of_range;
+                        val = 0;
+                        return Errc::none;
+                    }
+                }
+                return std::from_chars(first, last, val).ec == std::errc() ? Errc::none : Errc::out_of_range;
+            } else {
+                double d;
+                if (std::from_chars(first, last, d).ec != std::errc() || !fits<Num>(d)) return Errc::out_of_range;
+                val = static_cast<Num>(d);
+                return Errc::none;
+            }
+        }
+
+        /// Consume a string value and unescape it into val, a std::string
+        /// or any basic_string<char> such as std::pmr::string.
+        template<typename String>
+        bool string(String& val) {
+            std::string_view raw;
+            bool escaped;
+            if (!raw_string(raw, escaped)) return false;
+            if (!escaped) { val.assign(raw.data(), raw.size()); return true; }
+            val.clear();
+            return unescape(raw, val) || fail();
+        }
+
+        /// Where borrowed_string() puts strings which need unescaping.
+        /// Without it they fail to decode.
+        void set_string_storage(std::pmr::memory_resource* storage) { strings_ = storage; }
+
+        /// Consume a string value as a view into the text.  A string with
+        /// escapes is unescaped into the string storage instead.  Without
+        /// storage such a string, if well formed, is consumed and false
+        /// returned with failed() still false.
+        bool borrowed_string(std::string_view& val) {
+            bool escaped;
+            if (!raw_string(val, escaped)) return false;
+            if (!escaped) return true;
+            if (!strings_) {
+                scratch_.clear();
+                return unescape(val, scratch_) ? false : fail();
+            }
+            // Unescaping never makes a string longer.
+            CharBuffer out{static_cast<char*>(strings_->allocate(val.size(), 1))};
+            if (!unescape(val, out)) return fail();
+            val = std::string_view(out.data, out.size);
+            return true;
+        }
+
+        /// Consume a string value as a view valid until the next key or
+        /// string is read: into the text, or into the Reader's scratch
+        /// buffer when it has escapes.  For strings which are only looked
+        /// up, like enum names.
+        bool scratch_string(std::string_view& val) {
+            bool escaped;
+            if (!raw_string(val, escaped)) return false;
+            if (escaped) {
+                scratch_.clear();
+                if (!unescape(val, scratch_)) return fail();
+                val = scratch_;
+            }
+            return true;
+        }
+
+        /// Whether s is in the scratch buffer, which reading the next key or
+        /// scratch string, skip() included, overwrites.
+        bool in_scratch(std::string_view s) const { return s.data() == scratch_.data(); }
+
+        /// Begin an object.  Follow with next_key() until it returns false.
+        bool object_begin() { return expect('{'); }
+
+        /// Advance to the next member of the current object and consume its
+        /// key and colon.  Returns false at the closing brace or on failure.
+        /// The key is a view into the text, or into a scratch buffer owned by
+        /// the Reader when the key contains escapes.
+        bool next_key(std::string_view& key) {
+            if (!separator('}')) return false;
+            bool escaped;
+            if (!raw_string(key, escaped)) return false;
+            if (escaped) {
+                scratch_.clear();
+                if (!unescape(key, scratch_)) return fail();
+                key = scratch_;
+            }
+            return expect(':');
+        }
+
+        /// Begin an array.  Follow with next_element() until it returns false.
+        bool array_begin() { return expect('['); }
+
+        /// Advance to the next element of the current array.  Returns false
+        /// at the closing bracket or on failure.
+        bool next_element() { return separator(']'); }
+
+        /// True if the next value is an empty object or array.
+        bool empty_container() {
+            const Kind k = peek();
+            if (k != Kind::object && k != Kind::array) return false;
+            std::size_t p = pos_ + 1;
+            while (p < text_.size() && is_ws(text_[p])) ++p;
+            return p < text_.size() && text_[p] == (k == Kind::object ? '}' : ']');
+        }
+
+        /// Look ahead in the object which comes next for a member called
+        /// name, without consuming anything, and return its kind: end if
+        /// there is none.  A string's value is a view into the text, or
+        /// into the scratch buffer if it has escapes.
+        Kind find_member(std::string_view name, std::string_view& value) {
+            const std::size_t start = pos_;
+            Kind found = Kind::end;
+            if (object_begin()) {
+                std::string_view key;
+                while (next_key(key)) {
+                    if (key != name) {
+                        if (!skip()) break;
+                        continue;
+                    }
+                    found = peek();
+                    bool escaped;
+                    if (found == Kind::string) {
+                        if (!raw_string(value, escaped)) {
+                            found = Kind::invalid;
+                        } else if (escaped) {
+                            scratch_.clear();
+                            if (!unescape(value, scratch_)) found = Kind::invalid;
+                            value = scratch_;
+                        }
+                    }
+                    break;
+                }
+            }
+            seek(start);
+            return found;
+        }
+
+        /// Consume and discard the next value.
+        bool skip() { return skip_value(0); }
+
+    private:
+        static constexpr int max_depth = 512;
+
+        static bool is_ws(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+        void skip_ws() { while (pos_ < text_.size() && is_ws(text_[pos_])) ++pos_; }
+
+        bool fail() { failed_ = true; return false; }
+
+        bool expect(char c) {
+            skip_ws();
+            if (pos_ < text_.size() && text_[pos_] == c) { ++pos_; return true; }
+            return fail();
+        }
+
+        bool literal(std::string_view word) {
+            skip_ws();
+            if (text_.compare(pos_, word.size(), word) != 0) return fail();
+            pos_ += word.size();
+            return true;
+        }
+
+        // An int token, in range and with no fraction or exponent.  Eight
+        // digits at a time are validated and converted in one 64-bit word
+        // where the byte order allows, the rest one by one.
+        bool integer(int& val) {
+            const std::size_t size = text_.size();
+            std::size_t p = pos_;
+            const bool negative = p < size && text_[p] == '-';
+            if (negative) ++p;
+            const std::size_t start = p;
+            std::uint64_t mag = 0;
+            if (p < size && text_[p] == '0') {
+                ++p;
+            } else {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                if (p + 8 <= size) {
+                    std::uint64_t word;
+                    std::memcpy(&word, text_.data() + p, 8);
+                    if (eight_digits(word)) { mag = parse_eight_digits(word); p += 8; }
+                }
+#endif
+                // No int needs more than ten digits; the eleventh is
+                // consumed only so the range check below rejects it.
+                while (p < size && p - start < 11 && is_digit(text_[p])) {
+                    mag = mag * 10 + static_cast<unsigned>(text_[p] - '0');
+                    ++p;
+                }
+            }
+            if (p == start) return false;
+            if (p < size && (is_digit(text_[p]) || text_[p] == '.' || text_[p] == 'e' || text_[p] == 'E')) return false;
+            if (mag > (negative ? 2147483648u : 2147483647u)) return false;
+            val = static_cast<int>(negative ? -static_cast<std::int64_t>(mag) : static_cast<std::int64_t>(mag));
+            pos_ = p;
+            return true;
+        }
+
+        static bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+        // Eight ASCII digits packed little-endian in a word.
+        static bool eight_digits(std::uint64_t w) {
+            return ((w & 0xF0F0F0F0F0F0F0F0) | (((w + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+                == 0x3333333333333333;
+        }
+
+        static std::uint32_t parse_eight_digits(std::uint64_t w) {
+            const std::uint64_t mask = 0x000000FF000000FF;
+            const std::uint64_t mul1 = 0x000F424000000064; // 100 + (1000000 << 32)
+            const std::uint64_t mul2 = 0x0000271000000001; // 1 + (10000 << 32)
+            w -= 0x3030303030303030;
+            w = (w * 10) + (w >> 8);
+            w = (((w & mask) * mul1) + (((w >> 16) & mask) * mul2)) >> 32;
+            return static_cast<std::uint32_t>(w);
+        }
+
+        bool digits() {
+            const std::size_t start = pos_;
+            while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') ++pos_;
+            return pos_ != start;
+        }
+
+        // Between container elements: consume a comma, or the closer which
+        // ends the container.  The first call after the opener sees neither.
+        bool separator(char closer) {
+            skip_ws();
+            if (pos_ >= text_.size()) return fail();
+            if (text_[pos_] == closer) { ++pos_; return false; }
+            const char prev = text_[prev_nonws()];
+            if (prev == '{' || prev == '[') return true;
+            if (text_[pos_] != ',') return fail();
+            ++pos_;
+            skip_ws();
+            if (pos_ < text_.size() && text_[pos_] == closer) return fail(); // trailing comma
+            return true;
+        }
+
+        std::size_t prev_nonws() const {
+            std::size_t p = pos_;
+            while (p > 0 && is_ws(text_[p - 1])) --p;
+            return p - 1;
+        }
+
+        // The undecoded body of a string token, and whether it has escapes.
+        bool raw_string(std::string_view& raw, bool& escaped) {
+            if (!expect('"')) return false;
+            const std::size_t start = pos_;
+            escaped = false;
+            while (pos_ < text_.size()) {
+                const char c = text_[pos_];
+                if (c == '"') {
+                    raw = text_.substr(start, pos_ - start);
+                    ++pos_;
+                    return true;
+                }
+                if (static_cast<unsigned char>(c) < 0x20) return fail();
+                if (c == '\\') { escaped = true; ++pos_; }
+                ++pos_;
+            }
+            return fail();
+        }
+
+        static int hex4(std::string_view s, std::size_t at) {
+            if (at + 4 > s.size()) return -1;
+            int v = 0;
+            for (std::size_t i = at; i < at + 4; ++i) {
+                const char c = s[i];
+                v <<= 4;
+                if (c >= '0' && c <= '9') v |= c - '0';
+                else if (c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+                else return -1;
+            }
+            return v;
+        }
+
+        template<typename String>
+        static void append_utf8(String& out, std::uint32_t cp) {
+            if (cp < 0x80) { out += static_cast<char>(cp); }
+            else if (cp < 0x800) {
+                out += static_cast<char>(0xC0 | (cp >> 6));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else if (cp < 0x10000) {
+                out += static_cast<char>(0xE0 | (cp >> 12));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | (cp >> 18));
+                out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+        }
+
+        // Just enough of a string for unescape() to write into memory of
+        // known sufficient size.
+        struct CharBuffer {
+            char* data;
+            std::size_t size{0};
+            void reserve(std::size_t) {}
+            CharBuffer& operator+=(char c) { data[size++] = c; return *this; }
+        };
+
+        template<typename String>
+        static bool unescape(std::string_view raw, String& out) {
+            out.reserve(raw.size());
+            for (std::size_t i = 0; i < raw.size(); ++i) {
+                const char c = raw[i];
+                if (c != '\\') { out += c; continue; }
+                switch (raw[++i]) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    int hi = hex4(raw, i + 1);
+                    if (hi < 0) return false;
+                    i += 4;
+                    std::uint32_t cp = static_cast<std::uint32_t>(hi);
+                    if (cp >= 0xD800 && cp <= 0xDBFF) {
+                        if (i + 2 >= raw.size() || raw[i + 1] != '\\' || raw[i + 2] != 'u') return false;
+                        const int lo = hex4(raw, i + 3);
+                        if (lo < 0xDC00 || lo > 0xDFFF) return false;
+                        i += 6;
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (static_cast<std::uint32_t>(lo) - 0xDC00);
+                    } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                        return false;
+                    }
+                    append_utf8(out, cp);
+                    break;
+                }
+                default: return false;
+                }
+            }
+            return true;
+        }
+
+        bool skip_value(int depth) {
+            if (depth > max_depth) return fail();
+            switch (peek()) {
+            case Kind::null: return null();
+            case Kind::boolean: { bool b; return boolean(b); }
+            case Kind::number: { std::string_view t; bool i; return number(t, i); }
+            case Kind::string: { std::string_view s; bool e; return raw_string(s, e); }
+            case Kind::array:
+                array_begin();
+                while (next_element()) {
+                    if (!skip_value(depth + 1)) return false;
+                }
+                return !failed_;
+            case Kind::object: {
+                object_begin();
+                std::string_view key;
+                while (next_key(key)) {
+                    if (!skip_value(depth + 1)) return false;
+                }
+                return !failed_;
+            }
+            default: return fail();
+            }
+        }
+
+        std::string_view text_;
+        std::size_t pos_{0};
+        bool failed_{false};
+        std::string scratch_;   // unescaped keys and scratch strings, reused
+        std::pmr::memory_resource* strings_{nullptr};
+    };
+
+
+    /// Decode the next value from a Reader into a C++ value.  Mirrors
+    /// jsonstruct::Converter<T, JsonLibTraits>::fromJson, one specialization
+    /// per supported type.
+    template<typename T, typename Enable = void>
+    struct Decoder;
+
+    // Record why the value at start, expected to be of kind expected,
+    // could not be read: it is some other kind, or it is malformed.
+    // Returns false.
+    inline bool fail_read(const Reader& in, std::size_t start, Reader::Kind expected) {
+        return fail(in.kind_at(start) == expected ? Errc::syntax : Errc::type_mismatch);
+    }
+
+    // Every number type, from the number's text (see Reader::number_value).
+    template<typename Num>
+    struct Decoder<Num, std::enable_if_t<is_number_type<Num>::value>> {
+        static bool decode(Reader& in, Num& cpp_val) {
+            const std::size_t start = in.position();
+            std::string_view token;
+            bool is_integer;
+            if (!in.number(token, is_integer)) return fail_read(in, start, Reader::Kind::number);
+            const Errc err = Reader::number_value(token, is_integer, cpp_val);
+            return err == Errc::none || fail(err);
+        }
+    };
+
+    // Enums by name, or by the underlying integer (see enum.hpp).
+    template<typename E>
+    struct Decoder<E, std::enable_if_t<has_enum_names<E>::value>> {
+        static bool decode(Reader& in, E& cpp_val) {
+            if (in.peek() == Reader::Kind::string) {
+                const std::size_t start = in.position();
+                std::string_view name;
+                if (!in.scratch_string(name)) return fail_read(in, start, Reader::Kind::string);
+                return enum_from_name(name, cpp_val);
+            }
+            std::underlying_type_t<E> bits{};
+            if (!Decoder<std::underlying_type_t<E>>::decode(in, bits)) return false;
+            cpp_val = static_cast<E>(bits);
+            return true;
+        }
+    };
+
+    // Flag sets, from an array of names and integers.
+    template<typename E>
+    struct Decoder<E, std::enable_if_t<has_flag_names<E>::value>> {
+        static bool decode(Reader& in, E& cpp_val) {
+            using Underlying = std::underlying_type_t<E>;
+            std::size_t start = in.position();
+            if (!in.array_begin()) return fail_read(in, start, Reader::Kind::array);
+            Underlying bits = 0;
+            for (std::size_t index = 0; in.next_element(); ++index) {
+                Underlying more = 0;
+                bool ok;
+                if (in.peek() == Reader::Kind::string) {
+                    start = in.position();
+                    std::string_view name;
+                    ok = in.scratch_string(name) ? add_flag<E>(name, more) : fail_read(in, start, Reader::Kind::string);
+                } else {
+                    ok = Decoder<Underlying>::decode(in, more);
+                }
+                if (!ok) return fail_in(index);
+                bits |= more;
+            }
+            if (in.failed()) return fail(Errc::syntax);
+            cpp_val = static_cast<E>(bits);
+            return true;
+        }
+    };
+
+    template<>
+    struct Decoder<bool, void> {
+        static bool decode(Reader& in, bool& cpp_val) {
+            const std::size_t start = in.position();
+            return in.boolean(cpp_val) || fail_read(in, start, Reader::Kind::boolean);
+        }
+    };
+
+    // Points into the text, which must outlive it (see MappedFile).  A
+    // string with escapes can only be decoded given string storage (see
+    // Document); without it the decode fails with Errc::needs_storage.
+    template<>
+    struct Decoder<std::string_view, void> {
+        static bool decode(Reader& in, std::string_view& cpp_val) {
+            const std::size_t start = in.position();
+            if (in.borrowed_string(cpp_val)) return true;
+            return in.failed() ? fail_read(in, start, Reader::Kind::string) : fail(Errc::needs_storage);
+        }
+    };
+
+    template<typename Alloc>
+    struct Decoder<std::basic_string<char, std::char_traits<char>, Alloc>, void> {
+        static bool decode(Reader& in, std::basic_string<char, std::char_traits<char>, Alloc>& cpp_val) {
+            const std::size_t start = in.position();
+            return in.string(cpp_val) || fail_read(in, start, Reader::Kind::string);
+        }
+    };
+
+    // Shared by the sequence containers: vector, deque.  Elements are
+    // decoded in place, or by Reader::number_array() for std::vector of
+    // numbers.
+    template<typename Container>
+    struct SequenceDecoder {
+        using T_elem = typename Container::value_type;
+        static bool decode(Reader& in, Container& cpp_val) {
+            if constexpr (is_bulk_number<T_elem>::value && has_data<Container>::value) {
+                const std::size_t start = in.position();
+                if (in.number_array(cpp_val)) return true;
+                // Again element by element, which accepts the same, to
+                // find the element at fault.
+                in.seek(start);
+                if (decode_each(in, cpp_val)) return true;
+                cpp_val.clear();
+                return false;
+            } else {
+                return decode_each(in, cpp_val);
+            }
+        }
+
+        // The general path, one Decoder call per element.
+        static bool decode_each(Reader& in, Container& cpp_val) {
+            const std::size_t start = in.position();
+            if (!in.array_begin()) return fail_read(in, start, Reader::Kind::array);
+            cpp_val.clear();
+            while (in.next_element()) {
+                if constexpr (std::is_same_v<T_elem, bool>) {
+                    bool elem;
+                    if (!Decoder<bool>::decode(in, elem)) return fail_in(cpp_val.size());
+                    cpp_val.push_back(elem);
+                } else {
+                    cpp_val.emplace_back();
+                    if (!Decoder<T_elem>::decode(in, cpp_val.back())) return fail_in(cpp_val.size() - 1);
+                }
+            }
+            return !in.failed() || fail(Errc::syntax);
+        }
+    };
+
+    template<typename T_elem, typename Alloc>
+    struct Decoder<std::vector<T_elem, Alloc>, void> : SequenceDecoder<std::vector<T_elem, Alloc>> {};
+
+    template<typename T_elem, typename Alloc>
+    struct Decoder<std::deque<T_elem, Alloc>, void> : SequenceDecoder<std::deque<T_elem, Alloc>> {};
+
+    template<typename T_elem, std::size_t N>
+    struct Decoder<std::array<T_elem, N>, void> {
+        static bool decode(Reader& in, std::array<T_elem, N>& cpp_val) {
+            const std::size_t start = in.position();
+            if (!in.array_begin()) return fail_read(in, start, Reader::Kind::array);
+            std::size_t i = 0;
+            while (in.next_element()) {
+                if (i == N) return fail(Errc::type_mismatch);
+                if (!Decoder<T_elem>::decode(in, cpp_val[i])) return fail_in(i);
+                ++i;
+            }
+            if (in.failed()) return fail(Errc::syntax);
+            return i == N || fail(Errc::type_mismatch);
+        }
+    };
+
+    // Shared by the string-keyed maps.
+    template<typename Map>
+    struct MapDecoder {
+        static bool decode(Reader& in, Map& cpp_val) {
+            const std::size_t start = in.position();
+            if (!in.object_begin()) return fail_read(in, start, Reader::Kind::object);
+            cpp_val.clear();
+            using Key = typename Map::key_type;
+            std::string_view key;
+            while (in.next_key(key)) {
+                auto it = cpp_val.try_emplace(Key(key, typename Key::allocator_type(cpp_val.get_allocator()))).first;
+                if (!Decoder<typename Map::mapped_type>::decode(in, it->second)) return fail_in(it->first);
+            }
+            return !in.failed() || fail(Errc::syntax);
+        }
+    };
+
+    template<typename KeyAlloc, typename T_val, typename Compare, typename Alloc>
+    struct Decoder<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>, void>
+        : MapDecoder<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>> {};
+
+    template<typename KeyAlloc, typename T_val, typename Hash, typename Equal, typename Alloc>
+    struct Decoder<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>, void>
+        : MapDecoder<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>> {};
+
+    template<typename T_val>
+    struct Decoder<std::optional<T_val>, void> {
+        // As with the DOM backends, null, {} and [] all mean "no value".
+        static bool decode(Reader& in, std::optional<T_val>& cpp_val) {
+            if (in.peek() == Reader::Kind::null || in.empty_container()) {
+                cpp_val.reset();
+                return in.skip() || fail(Errc::syntax);
+            }
+            if (!cpp_val) cpp_val.emplace();
+            if (Decoder<T_val>::decode(in, *cpp_val)) {
+                return true;
+            }
+            cpp_val.reset();
+            return false;
+        }
+    };
+
+    template<typename T_val>
+    struct Decoder<std::unique_ptr<T_val>, void> {
+        static bool decode(Reader& in, std::unique_ptr<T_val>& cpp_val) {
+            if (in.peek() == Reader::Kind::null) {
+                cpp_val.reset();
+                return in.null() || fail(Errc::syntax);
+            }
+            if (!cpp_val) cpp_val = std::make_unique<T_val>();
+            if (Decoder<T_val>::decode(in, *cpp_val)) return true;
+            cpp_val.reset();
+            return false;
+        }
+    };
+
+    template<typename T_val>
+    struct Decoder<std::shared_ptr<T_val>, void> {
+        static bool decode(Reader& in, std::shared_ptr<T_val>& cpp_val) {
+            if (in.peek() == Reader::Kind::null) {
+                cpp_val.reset();
+                return in.null() || fail(Errc::syntax);
+            }
+            auto fresh = std::make_shared<T_val>();
+            if (!Decoder<T_val>::decode(in, *fresh)) {
+                cpp_val.reset();
+                return false;
+            }
+            cpp_val = std::move(fresh);
+            return true;
+        }
+    };
+
+    template<typename... Types>
+    struct Decoder<std::variant<Types...>, void> {
+        using Variant = std::variant<Types...>;
+
+        // As with the DOM backends: a tagged variant goes straight to the
+        // alternative its tag names, otherwise the first alternative which
+        // decodes wins.  Alternatives which can not accept the next value's
+        // kind are skipped, and each attempt restarts from the same position.
+        // The held alternative is decoded in place, so may be left partly
+        // overwritten by a failed attempt, as the DOM backends leave it.
+        static bool decode(Reader& in, Variant& cpp_val) {
+            const std::size_t start = in.position();
+            if constexpr (is_tagged_variant<Types...>) {
+                std::string_view name;
+                const Reader::Kind tag = in.find_member(variant_tag_key<Types...>, name);
+                if (tag != Reader::Kind::string) {
+                    if (in.kind_at(start) != Reader::Kind::object) return fail(Errc::type_mismatch);
+                    fail(tag == Reader::Kind::end ? Errc::missing_required : Errc::type_mismatch);
+                    return fail_in(variant_tag_key<Types...>);
+                }
+                bool success = false;
+                if (!((name == Types::json_tag ? (success = try_alternative<Types>(in, start, cpp_val), true) : false) || ...)) {
+                    fail(Errc::variant_no_match);
+                    return fail_in(variant_tag_key<Types...>);
+                }
+                return success;
+            } else {
+                const unsigned kind = kind_bits(in.peek());
+                return ((json_kinds<Types>::value & kind && try_alternative<Types>(in, start, cpp_val)) || ...)
+                    || fail(Errc::variant_no_match);
+            }
+        }
+    private:
+        static unsigned kind_bits(Reader::Kind k) {
+            switch (k) {
+            case Reader::Kind::null: return kind_null;
+            case Reader::Kind::boolean: return kind_boolean;
+            case Reader::Kind::number: return kind_number;
+            case Reader::Kind::string: return kind_string;
+            case Reader::Kind::array: return kind_array;
+            case Reader::Kind::object: return kind_object;
+            default: return 0;
+            }
+        }
+
+        template<typename Alt>
+        static bool try_alternative(Reader& in, std::size_t start, Variant& cpp_val) {
+            if (Alt* held = std::get_if<Alt>(&cpp_val)) {
+                if (Decoder<Alt>::decode(in, *held)) return true;
+            } else {
+                Alt temp_value{};
+                if (Decoder<Alt>::decode(in, temp_value)) {
+                    cpp_val.template emplace<Alt>(std::move(temp_value));
+                    return true;
+                }
+            }
+            in.seek(start);
+            return false;
+        }
+    };
+
+    template<typename T>
+    struct Decoder<T, std::enable_if_t<has_config_fields<T>::value>> {
+        static bool decode(Reader& in, T& out_obj) {
+            const std::size_t start = in.position();
+            if (!in.object_begin()) return fail_read(in, start, Reader::Kind::object);
+            return decode_members(in, out_obj, std::make_index_sequence<field_count<T>>{});
+        }
+
+    private:
+        template<std::size_t I>
+        static bool decode_member(Reader& in, T& out_obj) {
+            const auto& field = std::get<I>(field_table<T>());
+            using MemberType = std::decay_t<decltype(out_obj.*field.ptr_to_member)>;
+            return Decoder<MemberType>::decode(in, out_obj.*field.ptr_to_member) || fail_in(field.name);
+        }
+
+        // Each key in the text is sent to its field through FieldIndex.
+        template<std::size_t... Is>
+        static bool decode_members(Reader& in, T& out_obj, std::index_sequence<Is...>) {
+            using MemberDecoder = bool (*)(Reader&, T&);
+            static constexpr MemberDecoder decoders[] = {&decode_member<Is>..., nullptr};
+            const auto& index = FieldIndex<T>::get();
+
+            std::array<bool, sizeof...(Is)> seen{};
+            std::string_view key;
+            while (in.next_key(key)) {
+                const std::size_t i = index.find(key);
+                if (i == FieldIndex<T>::npos) {
+                    // Skipping reuses the scratch buffer an escaped key is in.
+                    const std::string kept = in.in_scratch(key) ? std::string(key) : std::string();
+                    if (!in.skip()) {
+                        fail(Errc::syntax);
+                        return fail_in(kept.empty() ? key : kept);
+                    }
+                } else {
+                    seen[i] = true;
+                    if (!decoders[i](in, out_obj)) return false;
+                }
+            }
+            if (in.failed()) return fail(Errc::syntax);
+            // Absent members get Field's default/required treatment.
+            FirstError success;
+            ((success &= seen[Is] || std::get<Is>(field_table<T>()).use_default(out_obj)), ...);
+            return success.result();
+        }
+    };
+
+    /// Decode a complete JSON text into obj.  Returns false if the text is
+    /// not valid JSON, has trailing content, or does not match T, with the
+    /// reason in last_error().  There is no string storage, so a
+    /// std::string_view member given a string with escapes fails with
+    /// Errc::needs_storage; decode through a Document for those.
+    template<typename T>
+    bool from_json(std::string_view text, T& obj) {
+        Reader in(text);
+        return Decoder<T>::decode(in, obj) && (in.at_end() || fail(Errc::syntax));
+    }
+
+    template<typename T>
+    bool from_json(const char* data, std::size_t size, T& obj) {
+        return from_json(std::string_view(data, size), obj);
+    }
+}
@@ -0,0 +1,513 @@
+#pragma once
+
+#include <jsonstruct/converter.hpp>
+#include <jsonstruct/dtoa.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace jsonstruct::stream {
+
+    /// Whose output to reproduce.  Both libraries sort object keys, but they
+    /// differ in number formatting, string escaping and pretty layout.
+    enum class Dialect {
+        nlohmann,   // nlohmann::json::dump(indent, indent_char)
+        jsoncpp     // Json::StreamWriterBuilder with "indentation" set
+    };
+
+    struct Format {
+        Dialect dialect = Dialect::nlohmann;
+        int indent = -1;        // < 0 is compact (jsoncpp: <= 0)
+        char indent_char = ' ';
+
+        static Format compact(Dialect d = Dialect::nlohmann) { return {d, -1, ' '}; }
+        /// As dump(4) for nlohmann, as operator<< for JsonCPP.
+        static Format pretty(Dialect d = Dialect::nlohmann) {
+            return d == Dialect::nlohmann ? Format{d, 4, ' '} : Format{d, 1, '\t'};
+        }
+    };
+
+    /// A Sink writing into a caller-supplied buffer.  Output beyond the
+    /// capacity is dropped and flagged; size() is then the size needed.
+    class BufferSink {
+    public:
+        BufferSink(char* data, std::size_t capacity) : data_(data), capacity_(capacity) {}
+        void push_back(char c) { if (size_ < capacity_) data_[size_] = c; ++size_; }
+        void append(const char* s, std::size_t n) {
+            if (size_ + n <= capacity_) std::memcpy(data_ + size_, s, n);
+            size_ += n;
+        }
+        std::size_t size() const { return size_; }
+        bool overflow() const { return size_ > capacity_; }
+    private:
+        char* data_;
+        std::size_t capacity_;
+        std::size_t size_{0};
+    };
+
+    /// A Sink which only counts bytes.
+    class CountingSink {
+    public:
+        void push_back(char) { ++size_; }
+        void append(const char*, std::size_t n) { size_ += n; }
+        std::size_t size() const { return size_; }
+    private:
+        std::size_t size_{0};
+    };
+
+    /// Emits JSON tokens to a Sink, which is anything with push_back(char)
+    /// and append(const char*, size_t) such as std::string.
+    ///
+    /// Containers are written as begin, then key()/element() before each
+    /// member, then end.  The emptiness of a container must be given to
+    /// both begin and end since "{}" and "[]" are written without layout.
+    template<typename Sink>
+    class Writer {
+    public:
+        using sink_type = Sink;
+
+        Writer(Sink& sink, const Format& format = {})
+            : sink_(sink), format_(format)
+            , pretty_(format.dialect == Dialect::nlohmann ? format.indent >= 0 : format.indent > 0) {}
+
+        const Sink& sink() const { return sink_; }
+
+        void null() { put("null"); after_key_ = false; }
+        void boolean(bool b) { put(b ? "true" : "false"); after_key_ = false; }
+
+        template<typename Int>
+        void integer(Int i) {
+            char buf[24];
+            const auto res = std::to_chars(buf, buf + sizeof(buf), i);
+            sink_.append(buf, static_cast<std::size_t>(res.ptr - buf));
+            after_key_ = false;
+        }
+
+        void real(double d) {
+            if (format_.dialect == Dialect::nlohmann) real_nlohmann(d);
+            else real_jsoncpp(d);
+            after_key_ = false;
+        }
+
+        void string(std::string_view s) { quoted(s); after_key_ = false; }
+
+        void object_begin(bool empty) { open('{', empty); }
+        void object_end(bool empty) { close('}', empty); }
+        void array_begin(bool empty) { open('[', empty); }
+        void array_end(bool empty) { close(']', empty); }
+
+        /// Start the next object member.
+        void key(std::string_view name, bool first) {
+            if (!first) sink_.push_back(',');
+            newline();
+            quoted(name);
+            if (!pretty_) sink_.push_back(':');
+            else if (format_.dialect == Dialect::nlohmann) put(": ");
+            else put(" : ");
+            after_key_ = true;
+        }
+
+        /// Start the next array element.
+        void element(bool first) {
+            if (!first) sink_.push_back(',');
+            newline();
+        }
+
+    private:
+        void put(std::string_view s) { sink_.append(s.data(), s.size()); }
+
+        void newline() {
+            if (!pretty_) return;
+            sink_.push_back('\n');
+            for (int i = 0; i < depth_ * format_.indent; ++i) sink_.push_back(format_.indent_char);
+        }
+
+        void open(char c, bool empty) {
+            // JsonCPP puts a non-empty container which is a member value on
+            // its own line.
+            if (!empty && after_key_ && format_.dialect == Dialect::jsoncpp) newline();
+            sink_.push_back(c);
+            if (!empty) ++depth_;
+            after_key_ = false;
+        }
+
+        void close(char c, bool empty) {
+            if (empty) return sink_.push_back(c);
+            --depth_;
+            newline();
+            sink_.push_back(c);
+        }
+
+        void quoted(std::string_view s) {
+            static constexpr char hex[] = "0123456789abcdef";
+            sink_.push_back('"');
+            std::size_t run = 0;   // start of the pending unescaped run
+            for (std::size_t i = 0; i < s.size(); ++i) {
+                const unsigned char c = static_cast<unsigned char>(s[i]);
+                const char* esc = nullptr;
+                switch (c) {
+                case '"': esc = "\\\""; break;
+                case '\\': esc = "\\\\"; break;
+                case '\b': esc = "\\b"; break;
+                case '\f': esc = "\\f"; break;
+                case '\n': esc = "\\n"; break;
+                case '\r': esc = "\\r"; break;
+                case '\t': esc = "\\t"; break;
+                default: break;
+                }
+                const bool control = c < 0x20;
+                const bool non_ascii = c >= 0x80 && format_.dialect == Dialect::jsoncpp;
+                if (!esc && !control && !non_ascii) continue;
+                sink_.append(s.data() + run, i - run);
+                if (esc) {
+                    put(esc);
+                } else if (control) {
+                    const char u[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                    sink_.append(u, 6);
+                } else {
+                    // JsonCPP escapes all non-ASCII as UTF-16 code units.
+                    const std::uint32_t cp = decode_utf8(s, i);
+                    if (cp >= 0x10000) {
+                        const std::uint32_t v = cp - 0x10000;
+                        put_u16(0xD800 + (v >> 10));
+                        put_u16(0xDC00 + (v & 0x3FF));
+                    } else {
+                        put_u16(cp);
+                    }
+                }
+                run = i + 1;
+            }
+            sink_.append(s.data() + run, s.size() - run);
+            sink_.push_back('"');
+        }
+
+        void put_u16(std::uint32_t u) {
+            static constexpr char hex[] = "0123456789abcdef";
+            const char b[6] = {'\\', 'u', hex[(u >> 12) & 0xF], hex[(u >> 8) & 0xF],
+                               hex[(u >> 4) & 0xF], hex[u & 0xF]};
+            sink_.append(b, 6);
+        }
+
+        // Decode the UTF-8 sequence starting at s[i], leaving i on its last
+        // byte.  Malformed input gives U+FFFD.
+        static std::uint32_t decode_utf8(std::string_view s, std::size_t& i) {
+            const unsigned char c = static_cast<unsigned char>(s[i]);
+            int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : -1;
+            if (extra < 0 || i + extra >= s.size()) return 0xFFFD;
+            std::uint32_t cp = c & (0x3F >> extra);
+            for (int k = 1; k <= extra; ++k) {
+                const unsigned char cc = static_cast<unsigned char>(s[i + k]);
+                if ((cc & 0xC0) != 0x80) return 0xFFFD;
+                cp = (cp << 6) | (cc & 0x3F);
+            }
+            i += extra;
+            return cp;
+        }
+
+        // JsonCPP: "%.17g", with ".0" appended to integral values.
+        void real_jsoncpp(double d) {
+            if (!std::isfinite(d)) {
+                put(std::isnan(d) ? "null" : d < 0 ? "-1e+9999" : "1e+9999");
+                return;
+            }
+            char buf[32];
+            const auto res = std::to_chars(buf, buf + sizeof(buf), d, std::chars_format::general, 17);
+            const std::string_view txt(buf, static_cast<std::size_t>(res.ptr - buf));
+            put(txt);
+            if (txt.find_first_of(".e") == std::string_view::npos) put(".0");
+        }
+
+        void real_nlohmann(double d) {
+            if (!std::isfinite(d)) { put("null"); return; }
+            char buf[32];
+            sink_.append(buf, static_cast<std::size_t>(dtoa::format_nlohmann(buf, d) - buf));
+        }
+
+        Sink& sink_;
+        Format format_;
+        bool pretty_;
+        int depth_{0};
+        bool after_key_{false};
+    };
+
+
+    /// Write a C++ value to a Writer.  Mirrors
+    /// jsonstruct::Converter<T, JsonLibTraits>::toJson, one specialization
+    /// per supported type.
+    template<typename T, typename Enable = void>
+    struct Encoder;
+
+    // Write one field or element (name is Field::name or any_element) in
+    // the Sink's instrumentation Scope, if it has one (see instrument.hpp),
+    // which is told the bytes written from the Sink's size().
+    template<typename T, typename Writer>
+    void encode_member(Writer& out, const char* name, const T& cpp_val) {
+        using Hooks = instrumentation_t<typename Writer::sink_type>;
+        if constexpr (std::is_same_v<Hooks, NoInstrumentation>) {
+            Encoder<T>::encode(out, cpp_val);
+        } else {
+            typename Hooks::Scope scope(name, Phase::encode);
+            const std::size_t before = out.sink().size();
+            Encoder<T>::encode(out, cpp_val);
+            scope.produced(out.sink().size() - before);
+        }
+    }
+
+    // Write a string-keyed map with its keys in sorted order, as the DOM
+    // libraries do.  Only the entry pointers are sorted, not the entries.
+    template<typename Writer, typename Map>
+    void encode_sorted(Writer& out, const Map& cpp_val) {
+        std::vector<const typename Map::value_type*> entries;
+        entries.reserve(cpp_val.size());
+        for (const auto& entry : cpp_val) entries.push_back(&entry);
+        std::sort(entries.begin(), entries.end(),
+                  [](const auto* a, const auto* b) { return a->first < b->first; });
+        out.object_begin(entries.empty());
+        bool first = true;
+        for (const auto* entry : entries) {
+            out.key(entry->first, first);
+            first = false;
+            encode_member<typename Map::mapped_type>(out, any_element, entry->second);
+        }
+        out.object_end(entries.empty());
+    }
+
+    // Floating point values are written as the double the DOM libraries
+    // would hold.
+    template<typename Num>
+    struct Encoder<Num, std::enable_if_t<is_number_type<Num>::value>> {
+        template<typename Writer>
+        static void encode(Writer& out, const Num& cpp_val) {
+            if constexpr (std::is_integral_v<Num>) out.integer(cpp_val);
+            else out.real(static_cast<double>(cpp_val));
+        }
+    };
+
+    // Enum names are written straight from their string literals.
+    template<typename E>
+    struct Encoder<E, std::enable_if_t<has_enum_names<E>::value>> {
+        template<typename Writer>
+        static void encode(Writer& out, const E& cpp_val) {
+            if (const char* name = EnumNames<E>::name(cpp_val)) out.string(name);
+            else out.integer(static_cast<std::underlying_type_t<E>>(cpp_val));
+        }
+    };
+
+    template<typename E>
+    struct Encoder<E, std::enable_if_t<has_flag_names<E>::value>> {
+        template<typename Writer>
+        static void encode(Writer& out, const E& cpp_val) {
+            // Any bit set is written, by name or in the integer.
+            const bool empty = static_cast<std::underlying_type_t<E>>(cpp_val) == 0;
+            out.array_begin(empty);
+            bool first = true;
+            const auto rest = EnumNames<E>::for_each_flag(cpp_val, [&](const char* name) {
+                out.element(first);
+                first = false;
+                out.string(name);
+            });
+            if (rest) {
+                out.element(first);
+                out.integer(rest);
+            }
+            out.array_end(empty);
+        }
+    };
+
+    template<>
+    struct Encoder<bool, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const bool& cpp_val) { out.boolean(cpp_val); }
+    };
+
+    template<>
+    struct Encoder<std::string_view, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const std::string_view& cpp_val) { out.string(cpp_val); }
+    };
+
+    template<typename Alloc>
+    struct Encoder<std::basic_string<char, std::char_traits<char>, Alloc>, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const std::basic_string<char, std::char_traits<char>, Alloc>& cpp_val) {
+            out.string(cpp_val);
+        }
+    };
+
+    // Shared by the sequence containers: vector, deque, array.
+    template<typename Container>
+    struct SequenceEncoder {
+        template<typename Writer>
+        static void encode(Writer& out, const Container& cpp_val) {
+            using T_elem = typename Container::value_type;
+            out.array_begin(cpp_val.empty());
+            bool first = true;
+            for (const auto& elem : cpp_val) {
+                out.element(first);
+                first = false;
+                encode_member<T_elem>(out, any_element, elem);
+            }
+            out.array_end(cpp_val.empty());
+        }
+    };
+
+    template<typename T_elem, typename Alloc>
+    struct Encoder<std::vector<T_elem, Alloc>, void> : SequenceEncoder<std::vector<T_elem, Alloc>> {};
+
+    template<typename T_elem, typename Alloc>
+    struct Encoder<std::deque<T_elem, Alloc>, void> : SequenceEncoder<std::deque<T_elem, Alloc>> {};
+
+    template<typename T_elem, std::size_t N>
+    struct Encoder<std::array<T_elem, N>, void> : SequenceEncoder<std::array<T_elem, N>> {};
+
+    template<typename KeyAlloc, typename T_val, typename Compare, typename Alloc>
+    struct Encoder<std::map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Compare, Alloc>, void> {
+        using Key = std::basic_string<char, std::char_traits<char>, KeyAlloc>;
+        template<typename Writer>
+        static void encode(Writer& out, const std::map<Key, T_val, Compare, Alloc>& cpp_val) {
+            if constexpr (std::is_same_v<Compare, std::less<Key>>
+                          || std::is_same_v<Compare, std::less<>>) {
+                // Already in the order both DOM libraries write keys.
+                out.object_begin(cpp_val.empty());
+                bool first = true;
+                for (const auto& [key, val] : cpp_val) {
+                    out.key(key, first);
+                    first = false;
+                    encode_member<T_val>(out, any_element, val);
+                }
+                out.object_end(cpp_val.empty());
+            } else {
+                encode_sorted(out, cpp_val);
+            }
+        }
+    };
+
+    template<typename KeyAlloc, typename T_val, typename Hash, typename Equal, typename Alloc>
+    struct Encoder<std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const std::unordered_map<std::basic_string<char, std::char_traits<char>, KeyAlloc>, T_val, Hash, Equal, Alloc>& cpp_val) {
+            encode_sorted(out, cpp_val);
+        }
+    };
+
+    template<typename T_val>
+    struct Encoder<std::unique_ptr<T_val>, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const std::unique_ptr<T_val>& cpp_val) {
+            if (cpp_val) Encoder<T_val>::encode(out, *cpp_val);
+            else out.null();
+        }
+    };
+
+    template<typename T_val>
+    struct Encoder<std::shared_ptr<T_val>, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const std::shared_ptr<T_val>& cpp_val) {
+            if (cpp_val) Encoder<T_val>::encode(out, *cpp_val);
+            else out.null();
+        }
+    };
+
+    template<typename T_val>
+    struct Encoder<std::optional<T_val>, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const std::optional<T_val>& cpp_val) {
+            if (cpp_val) Encoder<T_val>::encode(out, *cpp_val);
+            else out.null();
+        }
+    };
+
+    template<typename... Types>
+    struct Encoder<std::variant<Types...>, void> {
+        template<typename Writer>
+        static void encode(Writer& out, const std::variant<Types...>& cpp_val) {
+            std::visit([&](const auto& arg) {
+                using Alt = std::decay_t<decltype(arg)>;
+                if constexpr (is_tagged_variant<Types...>) {
+                    Encoder<Alt>::encode(out, arg, variant_tag_key<Types...>, Alt::json_tag);
+                } else {
+                    Encoder<Alt>::encode(out, arg);
+                }
+            }, cpp_val);
+        }
+    };
+
+    template<typename T>
+    struct Encoder<T, std::enable_if_t<has_config_fields<T>::value>> {
+        template<typename Writer>
+        static void encode(Writer& out, const T& obj) { encode(out, obj, nullptr, {}); }
+
+        // With one more string member, extra_key (unless null), as a tagged
+        // variant's discriminator.
+        template<typename Writer>
+        static void encode(Writer& out, const T& obj, const char* extra_key, std::string_view extra_value) {
+            const auto& fields = field_table<T>();
+            constexpr std::size_t nfields = field_count<T>;
+            // Both DOM libraries emit keys in sorted order, so we do too.
+            static const auto order = sorted_order(fields, std::make_index_sequence<nfields>{});
+            const bool empty = nfields == 0 && !extra_key;
+            out.object_begin(empty);
+            bool first = true;
+            auto put_extra = [&] {
+                out.key(extra_key, first);
+                out.string(extra_value);
+                first = false;
+                extra_key = nullptr;
+            };
+            for (std::size_t index : order) {
+                visit_field(fields, index, [&](const auto& field) {
+                    using MemberType = std::decay_t<decltype(obj.*field.ptr_to_member)>;
+                    if (extra_key && std::string_view(extra_key) < field.name) put_extra();
+                    out.key(field.name, first);
+                    encode_member<MemberType>(out, field.name, obj.*field.ptr_to_member);
+                });
+                first = false;
+            }
+            if (extra_key) put_extra();
+            out.object_end(empty);
+        }
+
+    private:
+        template<typename Fields, std::size_t... Is>
+        static std::array<std::size_t, sizeof...(Is)> sorted_order(const Fields& fields, std::index_sequence<Is...>) {
+            std::array<std::size_t, sizeof...(Is)> order{Is...};
+            const std::array<std::string_view, sizeof...(Is)> names{std::get<Is>(fields).name...};
+            std::sort(order.begin(), order.end(),
+                      [&](std::size_t a, std::size_t b) { return names[a] < names[b]; });
+            return order;
+        }
+    };
+
+    /// Write obj as JSON text to a Sink.
+    template<typename T, typename Sink>
+    void write_json(const T& obj, Sink& sink, const Format& format = {}) {
+        Writer<Sink> out(sink, format);
+        Encoder<T>::encode(out, obj);
+    }
+
+    /// Number of bytes write_json() would produce.  This encodes obj in
+    /// full, so it costs about as much as writing it.
+    template<typename T>
+    std::size_t json_size(const T& obj, const Format& format = {}) {
+        CountingSink counter;
+        write_json(obj, counter, format);
+        return counter.size();
+    }
+
+    /// Serialize obj to a string in one pass, growing it as it is written.
+    /// A caller needing a single allocation can reserve json_size() and
+    /// call write_json() instead.
+    template<typename T>
+    std::string to_json_string(const T& obj, const Format& format = {}) {
+        std::string text;
+        write_json(obj, text, format);
+        return text;
+    }
+}
@@ -1,8 +1,19 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
 namespace jsonstruct {
 
     // Generic JSON traits relied on for conversin 
+    //
+    // Everything fromJson() calls takes a const ValueType& and must use
+    // only the library's const operations, never one which can insert
+    // (like operator[]) or cache.  Any number of threads may then decode
+    // from one shared document at once, as long as none modifies it.  The
+    // non-const operations are for building values in toJson().
     template<typename ValueType_>
     struct Traits {
         using ValueType = ValueType_;
@@ -15,12 +26,22 @@ namespace jsonstruct {
         static bool is_bool(const ValueType& v) { /* ... */ return false; }
         static bool is_double(const ValueType& v) { /* ... */ return false; }
         static bool is_null(const ValueType& v) { /* ... */ return false; }
+        // Any integer, including those beyond 64 bits, and any number.
+        static bool is_integer(const ValueType& v) { /* ... */ return false; }
+        static bool is_number(const ValueType& v) { /* ... */ return false; }
 
         // Value retrieval
         static int get_int(const ValueType& v) { /* ... */ return 0; }
         static std::string get_string(const ValueType& v) { /* ... */ return {}; }
+        // The (unescaped) string's bytes without a copy, valid while v is
+        // and is not modified.  std::string_view fields borrow through it.
+        static std::string_view get_string_view(const ValueType& v) { /* ... */ return {}; }
         static bool get_bool(const ValueType& v) { /* ... */ return false; }
         static double get_double(const ValueType& v) { /* ... */ return 0.0; }
+        // The integer as held by the library, without going through double
+        // or text.  False if v is not an integer or does not fit out.
+        static bool get_int64(const ValueType& v, std::int64_t& out) { /* ... */ return false; }
+        static bool get_uint64(const ValueType& v, std::uint64_t& out) { /* ... */ return false; }
 
         // Value creation
         static ValueType create_object() { /* ... */ return {}; }
@@ -28,17 +49,44 @@ namespace jsonstruct {
         static ValueType create_null() { /* ... */ return {}; }
         static ValueType create_int(int val) { /* ... */ return {}; }
         static ValueType create_string(const std::string& val) { /* ... */ return {}; }
+        static ValueType create_string(std::string_view val) { /* ... */ return {}; }
+        // A string with static storage duration, which may be referenced
+        // rather than copied.  Enum names are written through it.
+        static ValueType create_static_string(const char* val) { /* ... */ return {}; }
         static ValueType create_bool(bool val) { /* ... */ return {}; }
         static ValueType create_double(double val) { /* ... */ return {}; }
+        static ValueType create_int64(std::int64_t val) { /* ... */ return {}; }
+        static ValueType create_uint64(std::uint64_t val) { /* ... */ return {}; }
+
+        // Parse JSON text in [begin, end) into out, reading it in place.
+        static bool parse(const char* begin, const char* end, ValueType& out) { /* ... */ return false; }
 
 
         // Object operations
         static bool has_member(const ValueType& obj, const char* name) { /* ... */ return false; }
-        static ValueType get_member(const ValueType& obj, const char* name) { /* ... */ return {}; }
+        // Single lookup: pointer to the member's value inside obj, or nullptr if absent.
+        // The read path uses this so that no JSON subtree is ever copied.
+        static const ValueType* find_member(const ValueType& obj, const char* name) { /* ... */ return nullptr; }
+        // Reference to an existing member, undefined if it is absent.
+        static const ValueType& get_member(const ValueType& obj, const char* name) { /* ... */ return obj; }
         static void set_member(ValueType& obj, const char* name, const ValueType& val) { /* ... */ }
+        // Converters pass freshly built values, which are moved into the parent.
+        static void set_member(ValueType& obj, const char* name, ValueType&& val) { /* ... */ }
 
         // Array operations
+        static std::size_t array_size(const ValueType& arr) { /* ... */ return 0; }
+        static void reserve_array(ValueType& arr, std::size_t n) { /* ... */ } // a hint, may do nothing
         static void append_array_element(ValueType& arr, const ValueType& val) { /* ... */ }
+        static void append_array_element(ValueType& arr, ValueType&& val) { /* ... */ }
+
+        // Bulk numeric arrays, used for std::vector of any number type (see
+        // is_number_type).  get_numbers() fills out[0, array_size(arr)) and
+        // fails if any element would not convert to Num on its own: not a
+        // number, not an integer for an integral Num, or out of its range.
+        template<typename Num>
+        static bool get_numbers(const ValueType& arr, Num* out) { /* ... */ return false; }
+        template<typename Num>
+        static ValueType create_numbers(const Num* data, std::size_t n) { /* ... */ return {}; }
 
         // Iteration (can be tricky to generalize perfectly, but common patterns exist)
         // For arrays: usually range-based for works if ValueType is iterable
@@ -53,6 +101,13 @@ namespace jsonstruct {
             // Default empty implementation, concrete traits will override
         }
 
+        // Read-only iteration used by the converters.  Keys are passed as
+        // std::string_view into the JSON value, so nothing is allocated.
+        template<typename Callback> // Callback signature: void(std::string_view key, const ValueType& value)
+        static void for_each_object_member(const ValueType& obj, Callback&& cb) {
+            // Default empty implementation, concrete traits will override
+        }
+
     };
   
 }
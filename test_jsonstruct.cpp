@@ -1,6 +1,8 @@
 #include "jsonstruct/converter.hpp"
+#include <algorithm>
 #include <fstream>
 #include <iostream> 
+#include <iterator>
 
 using namespace jsonstruct;
 
@@ -39,16 +41,27 @@ struct ServerConfig {
 };
 
 
+// Print a check's outcome, to std::cout if it passed, else to std::cerr,
+// and pass it on.
+bool report(bool ok, const std::string& passed, const std::string& failed)
+{
+    if (ok) {
+        std::cout << passed << std::endl;
+    } else {
+        std::cerr << failed << std::endl;
+    }
+    return ok;
+}
+
+
 #include <jsonstruct/jsoncpp.hpp>
 
+#include <jsonstruct/load.hpp>
+
 ServerConfig jsoncpp_config(const std::string& filename)
 {
-    std::ifstream fp(filename);
-    Json::Value input;
-    fp >> input;
-
     ServerConfig config;
-    if (Converter<ServerConfig, jsoncpp::Traits>::fromJson(input, config)) {
+    if (load<ServerConfig, jsoncpp::Traits>(filename, config)) {
         std::cout << "JsonCPP config loaded successfully." << std::endl;
         // ... use config_cpp ...
     } else {
@@ -71,11 +84,8 @@ void jsoncpp_default()
 
 ServerConfig nlohmann_config(const std::string& filename)
 {
-    std::ifstream ifs(filename);
-    auto input = nlohmann::json::parse(ifs);
-
     ServerConfig config;
-    if (Converter<ServerConfig, nlohmannjson::Traits>::fromJson(input, config)) {
+    if (load<ServerConfig, nlohmannjson::Traits>(filename, config)) {
         std::cout << "Nlohmann/json config loaded successfully." << std::endl;
         // ... use config ...
     } else {
@@ -93,6 +103,590 @@ void nlohmann_default()
     std::cout << output << "\n";
 }
 
+#include <jsonstruct/stream.hpp>
+#include <sstream>
+
+ServerConfig stream_config(const std::string& filename)
+{
+    ServerConfig config;
+    if (load(filename, config)) {
+        std::cout << "Stream config loaded successfully." << std::endl;
+    } else {
+        std::cerr << "Failed to configure ServerConfig with the stream reader." << std::endl;
+    }
+    return config;
+}
+
+#include <jsonstruct/stream_writer.hpp>
+
+// The stream writer must reproduce both DOM libraries byte for byte.
+bool stream_writer_matches(const ServerConfig& config)
+{
+    Json::StreamWriterBuilder compact;
+    compact["indentation"] = "";
+    Json::Value jv = Converter<ServerConfig, jsoncpp::Traits>::toJson(config);
+    nlohmann::json nj = Converter<ServerConfig, nlohmannjson::Traits>::toJson(config);
+
+    const bool ok =
+        stream::to_json_string(config) == nj.dump() &&
+        stream::to_json_string(config, stream::Format::pretty()) == nj.dump(4) &&
+        stream::to_json_string(config, stream::Format::compact(stream::Dialect::jsoncpp)) == Json::writeString(compact, jv) &&
+        stream::to_json_string(config, stream::Format::pretty(stream::Dialect::jsoncpp)) == Json::writeString(Json::StreamWriterBuilder(), jv);
+    return report(ok, "Stream writer output matches.",
+                  "Stream writer output differs from the DOM backends.");
+}
+
+#include <cmath>
+#include <cstring>
+#include <random>
+
+// Doubles and strings which need escaping.
+struct Samples {
+    std::vector<double> values;
+    std::vector<std::string> texts;
+
+    static auto config_fields() {
+        return std::make_tuple(make_field("values", &Samples::values), make_field("texts", &Samples::texts));
+    }
+};
+
+// The shortest round-trip doubles and the escapes, including JsonCPP's
+// \u escapes of non-ASCII text, match both DOM libraries byte for byte.
+bool stream_writer_text()
+{
+    Samples samples;
+    samples.values = {0.0, -0.0, 0.1, 1.0 / 3, 100, 1e21, 1e22, 1e-7, 123456789.125, -2.5e-300,
+                      5e-324, 2.2250738585072014e-308, 1.7976931348623157e308, 9007199254740993.0};
+    std::mt19937_64 rng(7);
+    while (samples.values.size() < 2000) {
+        const std::uint64_t bits = rng();
+        double x;
+        std::memcpy(&x, &bits, sizeof x);
+        if (std::isfinite(x)) samples.values.push_back(x);
+        samples.values.push_back(std::uniform_real_distribution<double>(-1e6, 1e6)(rng));
+    }
+    samples.texts = {"", "tab\there", "line\nbreak\r", std::string("nul\0byte", 8), "\x01\x1f\x7f",
+                     "quote\" backslash\\ slash/", "caf\xc3\xa9", "\xe6\x97\xa5\xe6\x9c\xac",
+                     "\xf0\x9f\x98\x80 emoji", "\xe2\x80\xa8 separator"};
+    Json::StreamWriterBuilder compact;
+    compact["indentation"] = "";
+    const Json::Value jv = Converter<Samples, jsoncpp::Traits>::toJson(samples);
+    const nlohmann::json nj = Converter<Samples, nlohmannjson::Traits>::toJson(samples);
+    const bool ok = stream::to_json_string(samples) == nj.dump()
+        && stream::to_json_string(samples, stream::Format::pretty()) == nj.dump(4)
+        && stream::to_json_string(samples, stream::Format::compact(stream::Dialect::jsoncpp))
+            == Json::writeString(compact, jv)
+        && stream::to_json_string(samples, stream::Format::pretty(stream::Dialect::jsoncpp))
+            == Json::writeString(Json::StreamWriterBuilder(), jv);
+    return report(ok, "Stream writer output matches for doubles and escaped text.",
+                  "Stream writer output differs for doubles or escaped text.");
+}
+
+// Defaults taken from the default member initializers.
+struct Limits {
+    std::string name = "limits";
+    int retries = 3;
+    std::vector<int> backoff = {1, 2, 4};
+
+    static auto config_fields() {
+        return std::make_tuple(
+            make_field("name", &Limits::name, member_default),
+            make_field("retries", &Limits::retries, member_default),
+            make_field("backoff", &Limits::backoff, member_default)
+        );
+    }
+};
+
+// A member_default field missing from the JSON gets its initializer's
+// value on every backend, whatever the member held before.
+bool member_defaults()
+{
+    const std::string text = R"({"retries": 5})";
+    const auto defaulted = [](const Limits& l) {
+        return l.name == "limits" && l.retries == 5 && l.backoff == std::vector<int>{1, 2, 4};
+    };
+    Limits from_jsoncpp, from_nlohmann, from_text;
+    for (Limits* l : {&from_jsoncpp, &from_nlohmann, &from_text}) {
+        l->name = "changed";
+        l->backoff.clear();
+    }
+    Json::Value jsoncpp_doc;
+    const bool ok = jsoncpp::Traits::parse(text.data(), text.data() + text.size(), jsoncpp_doc)
+        && Converter<Limits, jsoncpp::Traits>::fromJson(jsoncpp_doc, from_jsoncpp) && defaulted(from_jsoncpp)
+        && Converter<Limits, nlohmannjson::Traits>::fromJson(nlohmann::json::parse(text), from_nlohmann)
+        && defaulted(from_nlohmann)
+        && stream::from_json(text, from_text) && defaulted(from_text);
+    return report(ok, "Member defaults come from the member initializers.",
+                  "Member default not applied: " + stream::to_json_string(from_text));
+}
+
+// The same fields decoded by either strategy.
+template<Decode D>
+struct Keyed {
+    static constexpr auto json_decode = D;
+    std::string name;
+    int port = 1;
+    std::vector<int> tags = {1, 2};
+    ServerConfig::DatabaseConfig db;
+
+    static auto config_fields() {
+        return std::make_tuple(
+            make_field("name", &Keyed::name),
+            make_field("port", &Keyed::port, 8080),
+            make_field("tags", &Keyed::tags, member_default),
+            make_field("database", &Keyed::db)
+        );
+    }
+};
+
+// Dispatching on each key decodes as looking up each field does: the same
+// values and defaults, and the same failure, with unknown keys ignored.
+// Sixty-four unknown keys make sure some hash to the fields' slots.
+bool dispatch_decode()
+{
+    std::string unknown;
+    for (int i = 0; i < 64; ++i) unknown += R"("k)" + std::to_string(i) + R"(": [)" + std::to_string(i) + "], ";
+    // What both strategies make of text on both DOM backends, if they agree.
+    const auto decoded = [](const std::string& text) -> std::string {
+        const auto decode = [&](auto proto, auto traits) -> std::string {
+            using Traits = decltype(traits);
+            typename Traits::ValueType doc;
+            if (!Traits::parse(text.data(), text.data() + text.size(), doc)) return "unparsed";
+            proto.name = "before";
+            proto.tags.clear();
+            return Converter<decltype(proto), Traits>::fromJson(doc, proto) ? stream::to_json_string(proto)
+                                                                           : last_error().message();
+        };
+        const std::string lookup = decode(Keyed<Decode::lookup>{}, jsoncpp::Traits{});
+        const bool same = decode(Keyed<Decode::dispatch>{}, jsoncpp::Traits{}) == lookup
+            && decode(Keyed<Decode::dispatch>{}, nlohmannjson::Traits{}) == lookup
+            && decode(Keyed<Decode::lookup>{}, nlohmannjson::Traits{}) == lookup;
+        return same ? lookup : "strategies differ";
+    };
+    const std::string defaulted = R"({"database":{"max_connections":10,"password":"","user":"u"},)"
+                                  R"("name":"a","port":8080,"tags":[1,2]})";
+    const bool ok = FieldIndex<Keyed<Decode::dispatch>>::get().find("database") == 3
+        && FieldIndex<Keyed<Decode::dispatch>>::get().find("k0") == FieldIndex<Keyed<Decode::dispatch>>::npos
+        && decoded(R"({"name": "a", "port": 2, "tags": [3], "database": {"user": "u"}})")
+            == R"({"database":{"max_connections":10,"password":"","user":"u"},"name":"a","port":2,"tags":[3]})"
+        && decoded("{" + unknown + R"("database": {"user": "u"}, "name": "a"})") == defaulted
+        && decoded("{" + unknown + R"("name": "a"})") == "/database: missing required field"
+        && decoded(R"({"port": 2, "database": {"user": "u"}})") == "/name: missing required field"
+        && decoded(R"({"name": "a", "database": {}})") == "/database/user: missing required field"
+        && decoded(R"({"name": "a", "port": "x", "database": {"user": "u"}})") == "/port: type mismatch"
+        && decoded(R"({"name": 1, "port": "x", "database": {"user": "u"}})") == "/name: type mismatch"
+        && decoded("{}") == "/name: missing required field"
+        && decoded(R"([])") == "type mismatch";
+    return report(ok, "Dispatch decoding agrees with field lookup.",
+                  "Dispatch and lookup decoding differ: " + last_error().message());
+}
+
+#include <array>
+#include <deque>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+// What the jsoncpp, nlohmann and stream backends make of text, each
+// decoding into a fresh make(): outcome(ok, value), if all three agree.
+template<typename T, typename Make, typename Outcome>
+std::string decoded_everywhere(const std::string& text, Make make, Outcome outcome)
+{
+    T from_jsoncpp = make(), from_nlohmann = make(), from_text = make();
+    Json::Value jsoncpp_doc;
+    const std::string jsoncpp = jsoncpp::Traits::parse(text.data(), text.data() + text.size(), jsoncpp_doc)
+        ? outcome(Converter<T, jsoncpp::Traits>::fromJson(jsoncpp_doc, from_jsoncpp), from_jsoncpp)
+        : "unparsed";
+    const std::string nlohmann =
+        outcome(Converter<T, nlohmannjson::Traits>::fromJson(nlohmann::json::parse(text), from_nlohmann), from_nlohmann);
+    const std::string stream = outcome(stream::from_json(text, from_text), from_text);
+    return jsoncpp == nlohmann && nlohmann == stream ? stream : "backends differ";
+}
+
+// The same into a default-constructed T: the value re-encoded, or the error.
+template<typename T>
+std::string decoded_everywhere(const std::string& text)
+{
+    return decoded_everywhere<T>(text, [] { return T{}; }, [](bool ok, const T& value) {
+        return ok ? stream::to_json_string(value) : last_error().message();
+    });
+}
+
+struct Containers {
+    std::deque<int> queue;
+    std::array<double, 2> point{};
+    std::map<std::string, int> ports;
+    std::unordered_map<std::string, std::string> labels;
+    std::unique_ptr<ServerConfig::DatabaseConfig> primary;
+    std::shared_ptr<ServerConfig::DatabaseConfig> replica;
+
+    static auto config_fields() {
+        return std::make_tuple(
+            make_field("queue", &Containers::queue),
+            make_field("point", &Containers::point),
+            make_field("ports", &Containers::ports),
+            make_field("labels", &Containers::labels),
+            make_field("primary", &Containers::primary),
+            make_field("replica", &Containers::replica)
+        );
+    }
+};
+
+// deque, array, the maps and the smart pointers round trip on every
+// backend, the stream writer sorting unordered_map keys as the DOM
+// libraries do, and fail the same way on all of them.
+bool container_types()
+{
+    Containers value;
+    value.queue = {3, 1, 2};
+    value.point = {0.5, -1};
+    value.ports = {{"https", 443}, {"http", 80}};
+    for (const char* key : {"zeta", "alpha", "mu", "beta", "omega", "kappa", "delta", "pi"}) value.labels[key] = key;
+    value.primary = std::make_unique<ServerConfig::DatabaseConfig>();
+    value.primary->user = "admin";
+    const std::string text = stream::to_json_string(value);
+    Json::StreamWriterBuilder compact;
+    compact["indentation"] = "";
+
+    const auto decoded = [](const std::string& in) { return decoded_everywhere<Containers>(in); };
+    const std::string rest = R"("ports": {}, "labels": {}, "primary": null, "replica": null)";
+    const bool ok = text == Converter<Containers, nlohmannjson::Traits>::toJson(value).dump()
+        && stream::to_json_string(value, stream::Format::compact(stream::Dialect::jsoncpp))
+            == Json::writeString(compact, Converter<Containers, jsoncpp::Traits>::toJson(value))
+        && text.find(R"("labels":{"alpha":"alpha","beta":"beta","delta":"delta")") != std::string::npos
+        && decoded(text) == text
+        && decoded(R"({"queue": [], "point": [1, 2], "ports": {"a": 1}, "labels": {"b": "c"},)"
+                   R"( "primary": {"user": "u"}, "replica": {"user": "r"}})")
+            == R"({"labels":{"b":"c"},"point":[1.0,2.0],"ports":{"a":1},)"
+               R"("primary":{"max_connections":10,"password":"","user":"u"},)"
+               R"("queue":[],"replica":{"max_connections":10,"password":"","user":"r"}})"
+        && decoded(R"({"queue": [], "point": [1, 2, 3], )" + rest + "}") == "/point: type mismatch"
+        && decoded(R"({"queue": [], "point": [1], )" + rest + "}") == "/point: type mismatch"
+        && decoded(R"({"queue": [1, "x"], "point": [1, 2], )" + rest + "}") == "/queue/1: type mismatch"
+        && decoded(R"({"queue": [], "point": [1, 2], "ports": {"a": "x"}, "labels": {},)"
+                   R"( "primary": null, "replica": null})") == "/ports/a: type mismatch"
+        && decoded(R"({"queue": [], "point": [1, 2], "ports": {}, "labels": {},)"
+                   R"( "primary": {}, "replica": null})") == "/primary/user: missing required field"
+        && decoded(R"({"queue": [], "point": [1, 2], "ports": {}, "labels": {},)"
+                   R"( "primary": null, "replica": 3})") == "/replica: type mismatch";
+    return report(ok, "Deques, arrays, maps and smart pointers convert on every backend.",
+                  "Container conversion failed: " + text);
+}
+
+// Vectors of numbers are decoded in bulk; a deque takes the element by
+// element path.  Both accept and reject the same, at the same index, and
+// a vector which failed is left empty.
+bool bulk_numbers()
+{
+    // Each backend's outcome decoding text into proto, and for a vector
+    // whether it was left empty.
+    const auto decoded = [](auto proto, const std::string& text) {
+        using Seq = decltype(proto);
+        return decoded_everywhere<Seq>(text, [&] { return proto; }, [](bool ok, const Seq& seq) {
+            if (ok) return stream::to_json_string(seq);
+            return last_error().message() + (has_data<Seq>::value && !seq.empty() ? " (not cleared)" : "");
+        });
+    };
+    // The same outcome for vector and deque of Num, which is expected.
+    const auto both = [&](auto num, const std::string& text, const std::string& expected) {
+        using Num = decltype(num);
+        return decoded(std::vector<Num>{9, 9}, text) == expected && decoded(std::deque<Num>{}, text) == expected;
+    };
+    const bool ok = both(int{}, "[1, -2, 3]", "[1,-2,3]") && both(int{}, " [ ] ", "[]")
+        && both(int{}, R"([1, 2, "x"])", "/2: type mismatch")
+        && both(int{}, "[1, 2.5]", "/1: type mismatch")
+        && both(int{}, "[1, 3000000000]", "/1: number out of range")
+        && both(std::uint8_t{}, "[255, 256]", "/1: number out of range")
+        && both(std::uint8_t{}, "[-1]", "/0: number out of range")
+        && both(std::int64_t{}, "[-9223372036854775808, true]", "/1: type mismatch")
+        && both(float{}, "[0.5, 1e39]", "/1: number out of range")
+        && both(double{}, "[0.5, 1, -2e-3]", "[0.5,1.0,-0.002]")
+        && both(double{}, "[0.5, null]", "/1: type mismatch")
+        && decoded(std::vector<int>{}, R"({"a": 1})") == "type mismatch";
+    return report(ok, "Numeric vectors decode in bulk as element by element.",
+                  "Bulk number decoding differs: " + last_error().message());
+}
+
+#include <variant>
+
+struct Cat {
+    static constexpr const char* json_tag = "cat";
+    static constexpr const char* json_tag_key = "kind";
+    int lives = 9;
+    static auto config_fields() { return std::make_tuple(make_field("lives", &Cat::lives, 9)); }
+};
+
+struct Dog {
+    static constexpr const char* json_tag = "dog";
+    static constexpr const char* json_tag_key = "kind";
+    std::string name;
+    static auto config_fields() { return std::make_tuple(make_field("name", &Dog::name)); }
+};
+
+// An untagged variant takes the first alternative which accepts the
+// value's kind and converts it; a tagged one the alternative its tag
+// names.  The same on every backend.
+bool variant_dispatch()
+{
+    using Scalar = std::variant<int, double, bool, std::string, std::vector<int>, ServerConfig::DatabaseConfig>;
+    using Pet = std::vector<std::variant<Cat, Dog>>;
+    const auto decoded = [](auto proto, const std::string& text) {
+        using Type = decltype(proto);
+        return decoded_everywhere<Type>(text, [&] { return proto; }, [](bool ok, const Type& value) {
+            if (!ok) return last_error().message();
+            if constexpr (std::is_same_v<Type, Pet>) return stream::to_json_string(value);
+            else return std::to_string(value.index()) + " " + stream::to_json_string(value);
+        });
+    };
+    Pet pets{Cat{}, Dog{"rex"}};
+    const bool ok = decoded(Scalar{}, "2") == "0 2" && decoded(Scalar{}, "2.5") == "1 2.5"
+        && decoded(Scalar{std::string("held")}, "true") == "2 true"
+        && decoded(Scalar{}, R"("text")") == R"(3 "text")" && decoded(Scalar{}, "[1, 2]") == "4 [1,2]"
+        && decoded(Scalar{}, R"({"user": "u"})") == R"(5 {"max_connections":10,"password":"","user":"u"})"
+        && decoded(Scalar{}, "null") == "no variant alternative matches"
+        && decoded(Scalar{}, R"({"password": "p"})") == "no variant alternative matches"
+        && decoded(std::variant<double, int>{}, "2") == "0 2.0"
+        && stream::to_json_string(pets) == R"([{"kind":"cat","lives":9},{"kind":"dog","name":"rex"}])"
+        && Converter<Pet, nlohmannjson::Traits>::toJson(pets).dump() == stream::to_json_string(pets)
+        && decoded(Pet{}, R"([{"name": "a", "kind": "dog"}, {"kind": "cat"}])")
+            == R"([{"kind":"dog","name":"a"},{"kind":"cat","lives":9}])"
+        && decoded(Pet{}, R"([{"kind": "cat"}, {"name": "a"}])") == "/1/kind: missing required field"
+        && decoded(Pet{}, R"([{"kind": "cow"}])") == "/0/kind: no variant alternative matches"
+        && decoded(Pet{}, R"([{"kind": 1, "lives": 2}])") == "/0/kind: type mismatch"
+        && decoded(Pet{}, R"([{"kind": "dog"}])") == "/0/name: missing required field"
+        && decoded(Pet{}, R"(["cat"])") == "/0: type mismatch";
+    return report(ok, "Variants pick alternatives by kind and by tag.",
+                  "Variant dispatch failed: " + last_error().message());
+}
+
+#include <jsonstruct/arena.hpp>
+
+// Allocator-aware, so that decoding it into an Arena allocates nowhere else.
+struct ArenaConfig {
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+    std::pmr::string host;
+    std::pmr::vector<std::pmr::string> allowed_ips;
+    std::pmr::map<std::pmr::string, int> ports;
+
+    ArenaConfig(const allocator_type& alloc = {})
+        : host(alloc), allowed_ips(alloc), ports(alloc) {}
+    ArenaConfig(const ArenaConfig& other, const allocator_type& alloc)
+        : host(other.host, alloc), allowed_ips(other.allowed_ips, alloc), ports(other.ports, alloc) {}
+
+    static auto config_fields() {
+        return std::make_tuple(
+            make_field("host", &ArenaConfig::host),
+            make_field("allowed_ips", &ArenaConfig::allowed_ips),
+            make_field("ports", &ArenaConfig::ports)
+        );
+    }
+};
+
+// Decode with each backend into an Arena while the default memory resource
+// refuses to allocate: any std::pmr string which missed the arena throws.
+bool arena_decode()
+{
+    const std::string text = R"({"host": "a.host.name.longer.than.any.small.string",
+        "allowed_ips": ["10.0.0.1", "2001:0db8:85a3:0000:0000:8a2e:0370:7334"],
+        "ports": {"a port name longer than a small string": 8080}})";
+    Json::Value jv;
+    std::istringstream(text) >> jv;
+    const nlohmann::json nj = nlohmann::json::parse(text);
+
+    Arena arena;
+    ArenaConfig a = arena.make<ArenaConfig>();
+    ArenaConfig b = arena.make<ArenaConfig>();
+    ArenaConfig c = arena.make<ArenaConfig>();
+    std::pmr::memory_resource* saved = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    bool ok = false;
+    try {
+        ok = Converter<ArenaConfig, jsoncpp::Traits>::fromJson(jv, a)
+            && Converter<ArenaConfig, nlohmannjson::Traits>::fromJson(nj, b)
+            && stream::from_json(text, c);
+    } catch (const std::bad_alloc&) {
+        ok = false;
+    }
+    std::pmr::set_default_resource(saved);
+    ok = ok && a.host == b.host && b.host == c.host && a.allowed_ips == c.allowed_ips && a.ports == c.ports
+        && c.ports.begin()->second == 8080;
+    return report(ok, "Arena decode allocates only from the arena.",
+                  "Arena decode failed or allocated outside the arena.");
+}
+
+#include <jsonstruct/batch.hpp>
+
+// NDJSON of many ServerConfig records, one of them bad, decoded on several
+// threads: every record in order, and the bad one reported by index.
+bool batch_decode()
+{
+    std::string ndjson;
+    for (int i = 0; i < 1000; ++i) {
+        ServerConfig config;
+        config.port = i;
+        ndjson += i == 500 ? std::string(R"({"port": "not a number"})") : stream::to_json_string(config);
+        ndjson += '\n';
+    }
+    stream::BatchOptions options;
+    options.threads = 4;
+    options.chunk_records = 64;
+    const auto result = stream::decode_ndjson<ServerConfig>(ndjson, options);
+    bool ok = result.records.size() == 1000 && result.errors.size() == 1 && result.errors[0].index == 500;
+    for (int i = 0; ok && i < 1000; ++i) {
+        ok = i == 500 || result.records[i].port == i;
+    }
+    return report(ok, "Batch decode keeps order and reports the bad record.",
+                  "Batch decode lost order or misreported errors.");
+}
+
+#include <cstdio>
+#include <filesystem>
+
+// Records with std::string_view members borrow their strings from the
+// mapped file rather than copying them.
+struct Host {
+    std::string_view name;
+    int port = 0;
+
+    static auto config_fields() {
+        return std::make_tuple(make_field("name", &Host::name), make_field("port", &Host::port));
+    }
+};
+
+bool mapped_views()
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "test_jsonstruct.ndjson").string();
+    {
+        std::ofstream out(path);
+        out << R"({"name": "alpha", "port": 1})" << '\n' << R"({"name": "beta", "port": 2})" << '\n';
+    }
+    bool ok = false;
+    {
+        MappedFile file(path);
+        const auto result = load_batch<Host>(file);
+        ok = result.ok() && result.records.size() == 2
+            && result.records[1].name == "beta" && result.records[1].port == 2
+            && result.records[1].name.data() >= file.data()
+            && result.records[1].name.data() < file.data() + file.size();
+    }
+    std::remove(path.c_str());
+    // Host borrows, so only a MappedFile which outlives it can be loaded.
+    static_assert(borrows_text<Host>() && borrows_text<std::map<std::string, std::optional<Host>>>()
+                  && !borrows_text<ServerConfig>());
+    const auto missing = load_batch<ServerConfig>(path);
+    const auto unread = stream::decode_ndjson_file<ServerConfig>(path);
+    ok = ok && missing.errors.size() == 1 && missing.errors[0].code == Errc::unreadable
+        && unread.errors.size() == 1 && unread.errors[0].code == Errc::unreadable;
+    return report(ok, "Mapped records borrow strings from the file.",
+                  "Mapped batch load failed.");
+}
+
+#include <jsonstruct/document.hpp>
+
+// string_view fields borrow from a DOM too, and from a Document even when
+// the string had to be unescaped.  Without a Document there is nowhere to
+// unescape into, which is reported as such rather than as bad JSON.
+bool borrowed_strings()
+{
+    const nlohmann::json j = nlohmann::json::parse(R"({"name": "gamma", "port": 3})");
+    Host from_dom;
+    bool ok = Converter<Host, nlohmannjson::Traits>::fromJson(j, from_dom)
+        && from_dom.name.data() == j["name"].get_ref<const std::string&>().data();
+
+    Document doc(std::string(R"({"name": "tab\there", "port": 4})"));
+    Host from_doc;
+    ok = ok && doc.decode(from_doc) && from_doc.name == "tab\there" && from_doc.port == 4;
+    ok = ok && !stream::from_json(R"({"name": "a\nb", "port": 5})", from_doc)
+        && last_error().code() == Errc::needs_storage && last_error().path() == "/name"
+        && !stream::from_json(R"({"name": "a\qb", "port": 5})", from_doc)
+        && last_error().code() == Errc::syntax;
+    return report(ok, "String views borrow from the DOM and the Document.",
+                  "Borrowed string decode failed.");
+}
+
+#include <jsonstruct/delta.hpp>
+
+// A reload converts and reports only the fields which changed.
+bool delta_reload()
+{
+    Json::Value j = Converter<ServerConfig, jsoncpp::Traits>::toJson(ServerConfig{});
+    ServerConfig config;
+    DeltaState state;
+    const auto first = diff_apply<jsoncpp::Traits>(config, j, state);
+    const auto same = diff_apply<jsoncpp::Traits>(config, j, state);
+    j["database"]["user"] = "admin";
+    j["allowed_ips"].append("10.0.0.1");
+    const auto changed = diff_apply<jsoncpp::Traits>(config, j, state);
+    const bool ok = first.ok && first.paths.size() == 8 && same.ok && same.empty()
+        && changed.ok && changed.paths == std::vector<std::string>{"/database/user", "/allowed_ips"}
+        && changed.touches("/database") && !changed.touches("/host")
+        && config.db_config.user == "admin" && config.allowed_ips.size() == 2;
+    return report(ok, "Delta reload reports only the changed fields.",
+                  "Delta reload misreported changes.");
+}
+
+#include <jsonstruct/cbor.hpp>
+
+// CBOR written from the field descriptors is what nlohmann/json reads, and
+// what it writes decodes back to the same struct.
+bool cbor_round_trip(const ServerConfig& config)
+{
+    const auto expected = Converter<ServerConfig, nlohmannjson::Traits>::toJson(config);
+    ServerConfig back;
+    const bool ok = nlohmann::json::from_cbor(cbor::to_cbor(config)) == expected
+        && cbor::from_cbor(nlohmann::json::to_cbor(expected), back)
+        && stream::to_json_string(back) == stream::to_json_string(config);
+    return report(ok, "CBOR round trip agrees with nlohmann/json.",
+                  "CBOR round trip failed.");
+}
+
+#include <jsonstruct/packed.hpp>
+
+// Packed records round trip, and a stream of another type is refused.
+bool packed_records()
+{
+    std::vector<ServerConfig> configs(3);
+    configs[1].host = "packed";
+    configs[2].feature_activation = std::string("beta");
+    const auto bytes = packed::pack(configs);
+    std::vector<ServerConfig> back;
+    std::vector<Host> hosts;
+    // A bool byte or a variant index which no value has reads as a failure,
+    // not as the end of the records.
+    auto flags = packed::pack(std::vector<bool>{true, false});
+    flags.back() = 7;
+    auto choices = packed::pack(std::vector<std::variant<int, std::string>>{1});
+    choices[packed::header_size] = 5;
+    packed::RecordReader<bool> flag_reader(flags);
+    packed::RecordReader<std::variant<int, std::string>> choice_reader(choices);
+    bool flag;
+    std::variant<int, std::string> choice;
+    const bool one_flag = flag_reader.next(flag) && !flag_reader.next(flag) && flag_reader.failed();
+    const bool ok = packed::unpack(bytes, back) && back.size() == 3
+        && stream::to_json_string(back) == stream::to_json_string(configs)
+        && !packed::unpack(bytes, hosts)
+        && one_flag && !choice_reader.next(choice) && choice_reader.failed();
+    return report(ok, "Packed records round trip and check their schema.",
+                  "Packed records failed.");
+}
+
+#include <jsonstruct/columnar.hpp>
+
+// Columns read and write the same JSON as a vector of the records.
+bool columnar_round_trip()
+{
+    std::vector<ServerConfig> configs(3);
+    configs[0].port = 1;
+    configs[2].debug_mode = true;
+    const auto j = Converter<std::vector<ServerConfig>, nlohmannjson::Traits>::toJson(configs);
+    const std::string text = stream::to_json_string(configs);
+    Columns<ServerConfig> from_dom, from_text;
+    const bool ok = Converter<Columns<ServerConfig>, nlohmannjson::Traits>::fromJson(j, from_dom)
+        && Converter<Columns<ServerConfig>, nlohmannjson::Traits>::toJson(from_dom) == j
+        && stream::from_json(text, from_text) && stream::to_json_string(from_text) == text
+        && from_text.column<1>()[0] == 1 && from_text.row(2).debug_mode == true;
+    return report(ok, "Columns round trip like a vector of records.",
+                  "Columnar conversion failed.");
+}
 
 void demo_iteration() {
     // JsonCPP example
@@ -127,6 +721,438 @@ void demo_iteration() {
     }
 }
 
+#include <jsonstruct/lazy.hpp>
+
+// Lazy views convert only what is asked for, with fromJson()'s defaults.
+bool lazy_access()
+{
+    const std::string text = R"({"port": 9000, "database": {"user": "ro"}, "allowed_ips": "not an array"})";
+    const auto j = nlohmann::json::parse(text);
+    Lazy<ServerConfig, nlohmannjson::Traits> dom(j);
+    stream::Lazy<ServerConfig> raw(text);
+    const bool ok = dom.get(&ServerConfig::port) == 9000 && dom.get(&ServerConfig::db_config).user == "ro"
+        && *dom.find(&ServerConfig::host) == "localhost" && dom.ok()
+        && raw.get(&ServerConfig::port) == 9000 && raw.get(&ServerConfig::db_config).max_connections == 10
+        && raw.ok() && !raw.find(&ServerConfig::allowed_ips) && !raw.ok()
+        && dom.value().port == 9000 && !dom.ok();
+    return report(ok, "Lazy views convert fields on access.",
+                  "Lazy view access failed.");
+}
+
+#include <atomic>
+#include <thread>
+
+// Threads decoding overlapping and disjoint parts of one shared document
+// must all see what a single thread does.
+template<typename Traits>
+bool concurrent_decode_with(const std::vector<ServerConfig>& configs)
+{
+    const typename Traits::ValueType doc = Converter<std::vector<ServerConfig>, Traits>::toJson(configs);
+    const std::size_t nthreads = std::max(4u, std::thread::hardware_concurrency());
+    std::atomic<bool> ok{true};
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < nthreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int round = 0; round < 20; ++round) {
+                std::vector<ServerConfig> all;
+                if (!Converter<std::vector<ServerConfig>, Traits>::fromJson(doc, all) || all.size() != configs.size()
+                    || all.back().port != configs.back().port) {
+                    ok = false;
+                }
+                for (std::size_t i = t; i < configs.size(); i += nthreads) {
+                    ServerConfig one;
+                    if (!Converter<ServerConfig, Traits>::fromJson(doc[static_cast<int>(i)], one)
+                        || one.port != configs[i].port || one.db_config.user != configs[i].db_config.user) {
+                        ok = false;
+                    }
+                }
+                Lazy<ServerConfig, Traits> first(doc[0]);
+                if (first.get(&ServerConfig::host) != configs[0].host) ok = false;
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    return ok;
+}
+
+bool concurrent_decode()
+{
+    std::vector<ServerConfig> configs(64);
+    for (std::size_t i = 0; i < configs.size(); ++i) {
+        configs[i].port = static_cast<int>(i);
+        configs[i].debug_mode = i % 2 == 0;
+        configs[i].db_config.user = "user" + std::to_string(i);
+        configs[i].allowed_ips.assign(i % 5, "10.0.0." + std::to_string(i));
+    }
+    const bool ok = concurrent_decode_with<jsoncpp::Traits>(configs)
+        && concurrent_decode_with<nlohmannjson::Traits>(configs);
+    return report(ok, "Threads decode one shared document consistently.",
+                  "Concurrent decoding of a shared document failed.");
+}
+
+struct Named {
+    std::string s;
+    static auto config_fields() { return std::make_tuple(make_field("s", &Named::s)); }
+};
+
+struct Numbered {
+    int y = 0;
+    static auto config_fields() { return std::make_tuple(make_field("y", &Numbered::y)); }
+};
+
+// A failed field followed by a variant whose first alternative fails.
+struct Outer {
+    int first = 0;
+    std::variant<Named, Numbered> v;
+
+    static auto config_fields() {
+        return std::make_tuple(make_field("first", &Outer::first), make_field("v", &Outer::v));
+    }
+};
+
+// Failures say where and why, the same on every backend.
+bool error_paths()
+{
+    const std::string no_user = R"({"database": {"password": "x"}})";
+    const std::string bad_ip = R"({"database": {"user": "u"}, "allowed_ips": ["10.0.0.1", 3]})";
+    // An escaped unknown key, then a nested object whose own escaped keys
+    // (one too long to fit where the first was) are read while skipping.
+    const std::string escaped_unknown = R"({"x\u0041": {"\u0042": }})";
+    const std::string escaped_long = R"({"x\u0041": {"\u0042 a key longer than any short string buffer": }})";
+    ServerConfig config;
+    Columns<ServerConfig> columns;
+    Json::Value jsoncpp_doc;
+    const auto failure = [](bool decoded, Errc code, const std::string& path) {
+        return !decoded && last_error().code() == code && last_error().path() == path;
+    };
+    const bool ok = failure(stream::from_json(no_user, config), Errc::missing_required, "/database/user")
+        && last_error().message() == "/database/user: missing required field"
+        && jsoncpp::Traits::parse(no_user.data(), no_user.data() + no_user.size(), jsoncpp_doc)
+        && failure(Converter<ServerConfig, jsoncpp::Traits>::fromJson(jsoncpp_doc, config),
+                   Errc::missing_required, "/database/user")
+        && failure(Converter<ServerConfig, nlohmannjson::Traits>::fromJson(nlohmann::json::parse(bad_ip), config),
+                   Errc::type_mismatch, "/allowed_ips/1")
+        && failure(stream::from_json(bad_ip, config), Errc::type_mismatch, "/allowed_ips/1")
+        && failure(cbor::from_cbor(nlohmann::json::to_cbor(nlohmann::json::parse(no_user)), config),
+                   Errc::missing_required, "/database/user")
+        && failure(stream::from_json(R"({"port": 99999999999})", config), Errc::out_of_range, "/port")
+        && failure(stream::from_json(R"({"port": 80,)", config), Errc::syntax, "")
+        && failure(stream::from_json(escaped_unknown, config), Errc::syntax, "/xA")
+        && failure(stream::from_json(escaped_long, config), Errc::syntax, "/xA")
+        && failure(stream::from_json("[" + escaped_long + "]", columns), Errc::syntax, "/0/xA")
+        && decoded_everywhere<Outer>(R"({"first": "bad", "v": {"y": 3}})") == "/first: type mismatch"
+        && decoded_everywhere<Outer>(R"({"first": "bad", "v": 7})") == "/first: type mismatch"
+        && decoded_everywhere<Host>("{}") == "/name: missing required field";
+    return report(ok, "Decoding failures report a code and a JSON pointer.",
+                  "Unexpected decoding error: " + last_error().message());
+}
+
+#include <jsonstruct/profile.hpp>
+
+// The instrumented Traits count each field path it converts, and the
+// stream writer through a profile::Sink also the bytes each produces.
+bool profile_stats()
+{
+    using Profiled = profile::Traits<nlohmannjson::Traits>;
+    ServerConfig config;
+    config.allowed_ips = {"10.0.0.1", "10.0.0.2", "10.0.0.3"};
+    const auto j = Converter<ServerConfig, nlohmannjson::Traits>::toJson(config);
+    std::variant<std::vector<int>, std::vector<std::string>> ints_or_strings;
+
+    profile::Profile stats;
+    {
+        profile::Session session(stats);
+        for (int i = 0; i < 2; ++i) Converter<ServerConfig, Profiled>::fromJson(j, config);
+        Converter<ServerConfig, Profiled>::toJson(config);
+        Converter<decltype(ints_or_strings), Profiled>::fromJson(j["allowed_ips"], ints_or_strings);
+    }
+    Converter<ServerConfig, Profiled>::fromJson(j, config);   // no Session, not counted
+    profile::Profile written;
+    std::string text;
+    {
+        profile::Session session(written);
+        profile::Sink<std::string> sink(text);
+        stream::write_json(config, sink);
+    }
+    const auto produced = written.stats(Phase::encode);
+    const auto decode = stats.stats(Phase::decode);
+    const auto encode = stats.stats(Phase::encode);
+    const bool ok = decode.at("/database/user").calls == 2 && decode.at("/allowed_ips/*").calls == 6
+        && decode.at("").variant_retries == 1 && encode.at("/allowed_ips/*").calls == 3
+        && encode.at("/allowed_ips").calls == 1 && encode.at("/database/user").calls == 1
+        && encode.at("/database").produced_bytes == 0 && text == j.dump()
+        && produced.at("/allowed_ips/*").calls == 3 && produced.at("/allowed_ips/*").produced_bytes == 30
+        && produced.at("/allowed_ips").produced_bytes == 34
+        && produced.at("/database").produced_bytes == j["database"].dump().size()
+        && nlohmann::json::parse(stats.to_json())["decode"]["/port"]["calls"] == 2;
+    return report(ok, "Instrumented Traits profile each field path.",
+                  "Unexpected profile: " + stats.to_json());
+}
+
+#include <cstdint>
+#include <limits>
+
+struct Counters {
+    std::int64_t total = 0;
+    std::uint64_t bytes = 0;
+    std::uint8_t level = 0;
+    float ratio = 0;
+    std::vector<std::uint32_t> ids;
+
+    static auto config_fields() {
+        return std::make_tuple(
+            make_field("total", &Counters::total, member_default),
+            make_field("bytes", &Counters::bytes, member_default),
+            make_field("level", &Counters::level, member_default),
+            make_field("ratio", &Counters::ratio, member_default),
+            make_field("ids", &Counters::ids, member_default)
+        );
+    }
+};
+
+// Every number type converts at full width on every backend, and a number
+// which the type can not hold fails rather than wraps.
+bool numeric_types()
+{
+    Counters counters;
+    counters.total = std::numeric_limits<std::int64_t>::min();
+    counters.bytes = std::numeric_limits<std::uint64_t>::max();
+    counters.level = 255;
+    counters.ratio = 0.5f;
+    counters.ids = {0, 4000000000u};
+    const std::string text = stream::to_json_string(counters);
+    const auto same = [&](const Counters& c) { return stream::to_json_string(c) == text; };
+    const auto out_of_range = [](bool decoded, const std::string& path) {
+        return !decoded && last_error().code() == Errc::out_of_range && last_error().path() == path;
+    };
+    Counters from_jsoncpp, from_nlohmann, from_text, from_cbor, narrow;
+    std::vector<Counters> from_packed;
+    Json::Value jsoncpp_doc, big_ratio;
+    const std::string big = R"({"ratio": 1e300})";
+    const bool ok = jsoncpp::Traits::parse(text.data(), text.data() + text.size(), jsoncpp_doc)
+        && Converter<Counters, jsoncpp::Traits>::fromJson(jsoncpp_doc, from_jsoncpp) && same(from_jsoncpp)
+        && Converter<Counters, jsoncpp::Traits>::toJson(counters) == jsoncpp_doc
+        && Converter<Counters, nlohmannjson::Traits>::fromJson(nlohmann::json::parse(text), from_nlohmann)
+        && same(from_nlohmann)
+        && Converter<Counters, nlohmannjson::Traits>::toJson(counters) == nlohmann::json::parse(text)
+        && stream::from_json(text, from_text) && same(from_text)
+        && cbor::from_cbor(cbor::to_cbor(counters), from_cbor) && same(from_cbor)
+        && packed::unpack(packed::pack(std::vector<Counters>{counters}), from_packed) && same(from_packed.at(0))
+        && Converter<Counters, nlohmannjson::Traits>::fromJson(nlohmann::json::parse(R"({"ratio": 2})"), narrow)
+        && narrow.ratio == 2.0f
+        && out_of_range(stream::from_json(R"({"level": 256})", narrow), "/level")
+        && out_of_range(Converter<Counters, nlohmannjson::Traits>::fromJson(
+                            nlohmann::json::parse(R"({"ids": [1, -1]})"), narrow), "/ids/1")
+        && out_of_range(cbor::from_cbor(nlohmann::json::to_cbor(nlohmann::json::parse(R"({"total": 9223372036854775808})")), narrow), "/total")
+        && jsoncpp::Traits::parse(big.data(), big.data() + big.size(), big_ratio)
+        && out_of_range(Converter<Counters, jsoncpp::Traits>::fromJson(big_ratio, narrow), "/ratio");
+    return report(ok, "Every number type converts with range checks.",
+                  "Numeric conversion failed: " + text + " " + last_error().message());
+}
+
+enum class Level { debug, info, warn };
+
+constexpr auto json_enum_names(Level) {
+    return std::array{std::pair{Level::debug, "debug"}, std::pair{Level::info, "info"}, std::pair{Level::warn, "warn"}};
+}
+
+enum class Access : unsigned { read = 1, write = 2, exec = 4 };
+
+constexpr auto json_flag_names(Access) {
+    return std::array{std::pair{Access::read, "read"}, std::pair{Access::write, "write"}, std::pair{Access::exec, "exec"}};
+}
+
+struct Job {
+    Level level = Level::info;
+    Access access = Access::read;
+    std::vector<Level> history;
+
+    static auto config_fields() {
+        return std::make_tuple(
+            make_field("level", &Job::level, member_default),
+            make_field("access", &Job::access, member_default),
+            make_field("history", &Job::history, member_default)
+        );
+    }
+};
+
+// Enums are written by name and flag sets as arrays of names, the same on
+// every backend; a value or bit without a name as an integer.
+bool enum_names()
+{
+    static_assert(EnumNames<Level>::find("warn") == 2 && EnumNames<Level>::find("error") == EnumNames<Level>::npos);
+    Job job;
+    job.access = static_cast<Access>(1 | 4 | 16);
+    job.history = {Level::warn, static_cast<Level>(7)};
+    const std::string text = stream::to_json_string(job);
+    const auto same = [&](const Job& j) { return stream::to_json_string(j) == text; };
+    Job from_jsoncpp, from_nlohmann, from_text, from_cbor, bad;
+    std::vector<Job> from_packed;
+    Json::Value jsoncpp_doc;
+    const bool ok = text == R"({"access":["read","exec",16],"history":["warn",7],"level":"info"})"
+        && jsoncpp::Traits::parse(text.data(), text.data() + text.size(), jsoncpp_doc)
+        && Converter<Job, jsoncpp::Traits>::fromJson(jsoncpp_doc, from_jsoncpp) && same(from_jsoncpp)
+        && Converter<Job, jsoncpp::Traits>::toJson(job) == jsoncpp_doc
+        && Converter<Job, nlohmannjson::Traits>::fromJson(nlohmann::json::parse(text), from_nlohmann)
+        && same(from_nlohmann)
+        && stream::from_json(text, from_text) && same(from_text)
+        && cbor::from_cbor(cbor::to_cbor(job), from_cbor) && same(from_cbor)
+        && nlohmann::json::from_cbor(cbor::to_cbor(job)) == nlohmann::json::parse(text)
+        && packed::unpack(packed::pack(std::vector<Job>{job}), from_packed) && same(from_packed.at(0))
+        && stream::from_json(R"({"level": "w\u0061rn"})", bad) && bad.level == Level::warn
+        && !stream::from_json(R"({"access": ["read", "delete"]})", bad)
+        && last_error().code() == Errc::unknown_name && last_error().path() == "/access/1";
+    return report(ok, "Enums and flag sets convert by name.",
+                  "Enum conversion failed: " + text + " " + last_error().message());
+}
+
+#include <jsonstruct/schema.hpp>
+
+struct Circle {
+    static constexpr const char* json_tag = "circle";
+    double r = 1;
+    static auto config_fields() { return std::make_tuple(make_field("r", &Circle::r)); }
+};
+
+struct Square {
+    static constexpr const char* json_tag = "square";
+    double side = 1;
+    static auto config_fields() { return std::make_tuple(make_field("side", &Square::side)); }
+};
+
+struct Drawing {
+    std::string name;
+    std::vector<std::variant<Circle, Square>> shapes;
+    std::vector<Drawing> layers;
+
+    static auto config_fields() {
+        return std::make_tuple(
+            make_field("name", &Drawing::name),
+            make_field("shapes", &Drawing::shapes, member_default),
+            make_field("layers", &Drawing::layers, member_default)
+        );
+    }
+};
+
+// The exported schema describes the fields, and validate() accepts what
+// fromJson() accepts, failing with the same code and path.
+bool schema_validation()
+{
+    static_assert(!borrows_text<Drawing>(), "a recursive struct is looked through once");
+    using T = nlohmannjson::Traits;
+    const auto agree = [](auto proto, const std::string& text) {
+        using Type = decltype(proto);
+        const auto doc = nlohmann::json::parse(text);
+        const bool converted = Converter<Type, T>::fromJson(doc, proto);
+        const Error error = last_error();
+        const bool valid = validate<Type, T>(doc);
+        return valid == converted
+            && (valid || (last_error().code() == error.code() && last_error().path() == error.path()));
+    };
+    const auto config = json_schema<ServerConfig, T>();
+    const auto drawing = json_schema<Drawing, T>();
+    const auto job = json_schema<Job, T>();
+    const auto& shape = drawing["properties"]["shapes"]["items"]["oneOf"][1];
+    Json::Value jsoncpp_doc;
+    const std::string no_user = R"({"debug_mode": null, "database": {}})";
+    const bool ok = config["properties"]["port"] == nlohmann::json::parse(
+            R"({"type": "integer", "minimum": -2147483648, "maximum": 2147483647, "default": 8080})")
+        && config["required"] == nlohmann::json::parse(R"(["debug_mode", "database"])")
+        && config["properties"]["database"]["required"] == nlohmann::json::parse(R"(["user"])")
+        && config["properties"]["feature_activation"]["anyOf"][1]["type"] == "string"
+        && config["properties"]["debug_mode"]["anyOf"].size() == 4
+        && drawing["properties"]["layers"]["items"]["$ref"] == "#"
+        && shape["properties"]["type"]["const"] == "square"
+        && shape["required"] == nlohmann::json::parse(R"(["type", "side"])")
+        && job["properties"]["level"]["anyOf"][0]["enum"] == nlohmann::json::parse(R"(["debug", "info", "warn"])")
+        && job["properties"]["access"]["type"] == "array"
+        && validate<ServerConfig, T>(Converter<ServerConfig, T>::toJson(ServerConfig{}))
+        && agree(ServerConfig{}, R"({"debug_mode": {}, "database": {"user": "u"}})")
+        && agree(ServerConfig{}, R"({"database": {"user": "u"}, "allowed_ips": ["10.0.0.1", 3]})")
+        && agree(ServerConfig{}, R"({"debug_mode": true, "port": 99999999999, "database": {"user": "u"}})")
+        && agree(ServerConfig{}, R"({"debug_mode": true, "feature_activation": 3, "database": {"user": "u"}})")
+        && agree(ServerConfig{}, R"([])")
+        && agree(Drawing{}, R"({"name": "a", "shapes": [{"type": "circle", "r": 2}], "layers": [{"name": "b"}]})")
+        && agree(Drawing{}, R"({"name": "a", "shapes": [{"type": "triangle"}]})")
+        && agree(Drawing{}, R"({"name": "a", "shapes": [{"r": 2}]})")
+        && agree(Drawing{}, R"({"name": "a", "layers": [{"name": "b", "shapes": [{"type": "square"}]}]})")
+        && agree(Job{}, R"({"access": ["read", "delete"], "history": ["info", 1.5]})")
+        && agree(Counters{}, R"({"ids": [1, 2, -3]})")
+        && agree(Outer{}, R"({"first": "bad", "v": {"y": 3}})")
+        && agree(Outer{}, R"({"first": "bad", "v": 7})")
+        && agree(Host{}, "{}")
+        && jsoncpp::Traits::parse(no_user.data(), no_user.data() + no_user.size(), jsoncpp_doc)
+        && !validate<ServerConfig, jsoncpp::Traits>(jsoncpp_doc)
+        && last_error().code() == Errc::missing_required && last_error().path() == "/database/user";
+    return report(ok, "Schemas are exported and validation agrees with decoding.",
+                  "Schema or validation mismatch: " + last_error().message() + "\n"
+                      + config.dump() + "\n" + drawing.dump());
+}
+
+#include <jsonstruct/chunked.hpp>
+#include <random>
+
+// Text fed in pieces of any size, down to single bytes, decodes to what
+// stream::from_json() makes of it whole.  The bad texts below fail with
+// the same error too; mangled ones need only be rejected alike.
+bool chunked_decode()
+{
+    const auto agree = [](auto proto, const std::string& text) {
+        using Type = decltype(proto);
+        Type whole = proto;
+        const bool decoded = stream::from_json(text, whole);
+        const std::string expect = decoded ? stream::to_json_string(whole) : last_error().message();
+        for (std::size_t step = 1; step <= text.size(); ++step) {
+            Type part = proto;
+            stream::ChunkedDecoder decoder(part);
+            bool ok = true;
+            for (std::size_t at = 0; ok && at < text.size(); at += step) ok = decoder.feed(text.substr(at, step));
+            ok = ok && decoder.finish();
+            if (ok != decoded || (ok ? stream::to_json_string(part) : last_error().message()) != expect) return false;
+        }
+        return true;
+    };
+    ServerConfig config;
+    config.allowed_ips = {"10.0.0.1", "10.0.0.2"};
+    const bool ok = agree(ServerConfig{}, stream::to_json_string(config, stream::Format::pretty()))
+        && agree(Drawing{}, R"({"name": "aé", "shapes": [{"type": "circle", "r": 2}, {"side": 3, "type": "square"}],)"
+                            R"( "layers": [{"name": "b", "extra": {"x": [1, {"y": "}"}]}}]})")
+        && agree(Job{}, R"({"level": "warn", "access": ["read", "exec", 16], "history": ["debug", 2]})")
+        && agree(Drawing{}, R"({"name": "a", "layers": [{"name": "b"}, {"shapes": []}]})")
+        && agree(Drawing{}, R"({"name": "a", "shapes": [{"type": "circle", "r": tru}]})")
+        && agree(Drawing{}, R"({"name": "a"} x)");
+
+    const std::string drawing = R"({"name": "a\u00e9", "shapes": [{"type": "circle", "r": 2}, {"side": 3,)"
+        R"( "type": "square"}], "layers": [{"name": "b", "extra": {"x": [1, {"y\"": "}"}]}}]})";
+    const std::string alphabet = "{}[]\":,-0 1.etn\\x";
+    std::mt19937 random(1);
+    int differ = 0;
+    for (int run = 0; run < 5000; ++run) {
+        std::string text = drawing;
+        for (int edits = 1 + random() % 3; edits-- > 0;) {
+            const std::size_t at = random() % text.size();
+            const char c = alphabet[random() % alphabet.size()];
+            switch (random() % 3) {
+            case 0: text[at] = c; break;
+            case 1: text.insert(at, 1, c); break;
+            default: text.erase(at, 1);
+            }
+        }
+        Drawing whole, part;
+        const bool decoded = stream::from_json(text, whole);
+        stream::ChunkedDecoder decoder(part);
+        bool fed = true;
+        for (std::size_t at = 0, step = 1; fed && at < text.size(); at += step, step = 1 + random() % 7) {
+            fed = decoder.feed(text.substr(at, step));
+        }
+        fed = fed && decoder.finish();
+        if (fed != decoded || (fed && stream::to_json_string(part) != stream::to_json_string(whole))) ++differ;
+    }
+    return report(ok && differ == 0, "Chunked decoding matches whole-text decoding.",
+                  "Chunked decoding differs: " + last_error().message() + ", "
+                      + std::to_string(differ) + " mangled texts judged otherwise");
+}
+
 int main (int argc, char* argv[])
 {
     if (argc < 2) {
@@ -135,13 +1161,26 @@ int main (int argc, char* argv[])
         jsoncpp_default();
         demo_iteration();
 
-        return 0;
+        // Every check runs, so one failing does not hide the others.
+        const bool passed[] = {
+            stream_writer_matches(ServerConfig{}), stream_writer_text(), member_defaults(), dispatch_decode(),
+            container_types(), bulk_numbers(), variant_dispatch(), arena_decode(), batch_decode(),
+            mapped_views(), borrowed_strings(), delta_reload(), cbor_round_trip(ServerConfig{}),
+            packed_records(), columnar_round_trip(), lazy_access(), concurrent_decode(), error_paths(),
+            profile_stats(), numeric_types(), enum_names(), schema_validation(), chunked_decode(),
+        };
+        const auto failed = std::count(std::begin(passed), std::end(passed), false);
+        if (failed) {
+            std::cerr << failed << " of " << std::size(passed) << " checks failed." << std::endl;
+        }
+        return failed ? 1 : 0;
     }
 
     auto a = jsoncpp_config(argv[1]);
     auto b = nlohmann_config(argv[1]);
+    auto c = stream_config(argv[1]);
 
-    return 0;
+    return stream_writer_matches(c) ? 0 : 1;
 }
 
 